@@ -0,0 +1,111 @@
+/**
+ * @file SensoresBinario.ino
+ * @brief Sketch de prueba para el protocolo de texto y el binario con CRC-16
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Simula NUM_SENSORES sensores (la mitad de temperatura y la mitad de
+ * presión). Arranca enviando texto "T T-000 23.5" / "P P-001 101325"
+ * y cambia a tramas binarias de 10 bytes al recibir "MODO BINARIO".
+ * Para arrancar directamente en binario (prueba de autodetección),
+ * definir INICIAR_EN_BINARIO en 1.
+ *
+ * Formato de trama: ver codigo/ProtocoloBinario.h
+ */
+
+#define BAUDIOS 115200
+#define NUM_SENSORES 8
+#define PERIODO_MS 50
+#define INICIAR_EN_BINARIO 0
+
+const uint8_t SINCRONIA = 0xA5;
+
+bool modoBinario = INICIAR_EN_BINARIO;
+uint16_t siguienteSensor = 0;
+String comando = "";
+
+// CRC-16/CCITT-FALSE (polinomio 0x1021, inicial 0xFFFF)
+uint16_t crc16(const uint8_t* datos, uint8_t longitud) {
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < longitud; i++) {
+    crc ^= (uint16_t)datos[i] << 8;
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+void enviarTrama(uint16_t indice, char tipo, int32_t valor) {
+  uint8_t trama[10];
+  trama[0] = SINCRONIA;
+  trama[1] = (uint8_t)(indice);
+  trama[2] = (uint8_t)(indice >> 8);
+  trama[3] = (uint8_t)tipo;
+  trama[4] = (uint8_t)(valor);
+  trama[5] = (uint8_t)(valor >> 8);
+  trama[6] = (uint8_t)(valor >> 16);
+  trama[7] = (uint8_t)(valor >> 24);
+  uint16_t crc = crc16(trama + 1, 7);
+  trama[8] = (uint8_t)(crc);
+  trama[9] = (uint8_t)(crc >> 8);
+  Serial.write(trama, sizeof(trama));
+}
+
+void enviarTexto(uint16_t indice, char tipo, int32_t valor) {
+  char linea[32];
+  if (tipo == 'T') {
+    // valor en centésimas de grado; el signo aparte para que -0.50 no salga como 0.50
+    snprintf(linea, sizeof(linea), "T T-%03u %s%ld.%02ld", indice, valor < 0 ? "-" : "",
+             labs((long)valor) / 100, labs((long)valor) % 100);
+  } else {
+    snprintf(linea, sizeof(linea), "P P-%03u %ld", indice, valor);
+  }
+  Serial.println(linea);
+}
+
+void revisarComandos() {
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c == '\n') {
+      comando.trim();
+      if (comando == "MODO BINARIO") {
+        modoBinario = true;
+      } else if (comando == "MODO TEXTO") {
+        modoBinario = false;
+      }
+      comando = "";
+    } else if (comando.length() < 32) {
+      comando += c;
+    }
+  }
+}
+
+void setup() {
+  Serial.begin(BAUDIOS);
+  randomSeed(analogRead(A0));
+  if (!modoBinario) {
+    Serial.println("=== Arduino listo ===");
+    Serial.println("Formato: T ID VALOR  o  P ID VALOR");
+  }
+}
+
+void loop() {
+  revisarComandos();
+
+  uint16_t indice = siguienteSensor;
+  siguienteSensor = (siguienteSensor + 1) % NUM_SENSORES;
+
+  char tipo = (indice < NUM_SENSORES / 2) ? 'T' : 'P';
+  int32_t valor = (tipo == 'T') ? 2200 + random(-300, 300)       // 19.00 - 25.00 °C
+                                : 101325 + random(-500, 500);     // Pa
+
+  if (modoBinario) {
+    enviarTrama(indice, tipo, valor);
+  } else {
+    enviarTexto(indice, tipo, valor);
+  }
+
+  delay(PERIODO_MS);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file AgregadoLecturas.h
+ * @brief Resumen combinable (cuenta, suma, mínimo, máximo) de un conjunto de lecturas
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ */
+
+#ifndef AGREGADOLECTURAS_H
+#define AGREGADOLECTURAS_H
+
+#include <limits>
+
+/**
+ * @struct AgregadoLecturas
+ * @brief Resultado parcial de una reducción sobre lecturas
+ *
+ * @details
+ * Dos agregados de conjuntos disjuntos se combinan sin volver a recorrer
+ * las lecturas, por lo que cada hilo (o cada almacén) puede reducir su
+ * parte y los parciales se unen al final. El promedio se deriva de
+ * suma / cuenta en lugar de guardarse.
+ *
+ * Ejemplo de uso:
+ * @code
+ * AgregadoLecturas a, b;
+ * a.agregar(21.5);
+ * b.agregar(19.0);
+ * a.combinar(b);          // a.cuenta == 2, a.minimo == 19.0
+ * @endcode
+ */
+struct AgregadoLecturas {
+    long long cuenta;   ///< Lecturas incluidas
+    double suma;        ///< Suma de las lecturas
+    double minimo;      ///< Menor lectura (+inf si cuenta == 0)
+    double maximo;      ///< Mayor lectura (-inf si cuenta == 0)
+
+    AgregadoLecturas()
+        : cuenta(0), suma(0.0),
+          minimo(std::numeric_limits<double>::infinity()),
+          maximo(-std::numeric_limits<double>::infinity()) {}
+
+    void agregar(double valor) {
+        cuenta++;
+        suma += valor;
+        if (valor < minimo) minimo = valor;
+        if (valor > maximo) maximo = valor;
+    }
+
+    void combinar(const AgregadoLecturas& otro) {
+        cuenta += otro.cuenta;
+        suma += otro.suma;
+        if (otro.minimo < minimo) minimo = otro.minimo;
+        if (otro.maximo > maximo) maximo = otro.maximo;
+    }
+
+    bool estaVacio() const {
+        return cuenta == 0;
+    }
+
+    double promedio() const {
+        return cuenta > 0 ? suma / cuenta : 0.0;
+    }
+};
+
+#endif // AGREGADOLECTURAS_H
@@ -0,0 +1,459 @@
+/**
+ * @file AlmacenColumnar.h
+ * @brief Motor de almacenamiento columnar (estructura de arreglos) para la flota
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Alternativa a ListaGeneral para recorridos de toda la flota. En lugar
+ * de un objeto por sensor con una lista de nodos por lectura, cada tipo
+ * de sensor vive en una TablaColumnar: índice denso, columna de IDs
+ * y un segmento contiguo de valores por sensor. Un agregado de flota es
+ * un recorrido lineal de arreglos en vez de tres niveles de punteros.
+ */
+
+#ifndef ALMACENCOLUMNAR_H
+#define ALMACENCOLUMNAR_H
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include "ExportadorLecturas.h"
+#include "ListaGeneral.h"
+#include "MemoriaHeap.h"
+#include "Metricas.h"
+#include "MotorReglas.h"
+#include "ParserArduino.h"
+#include "SensorBase.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+#include "SensorVibracion.h"
+#include "TablaSimbolos.h"
+
+/**
+ * @class TablaColumnar
+ * @brief Sensores de un mismo tipo almacenados por columnas
+ * @tparam T Tipo de dato de las lecturas (float, int, ...)
+ *
+ * @details
+ * Todas las columnas están indexadas por el índice denso del sensor
+ * (0..numSensores-1):
+ * - @c ids: ID internado de cada sensor (el nombre vive en TablaSimbolos)
+ * - @c valores: puntero al segmento contiguo de lecturas del sensor
+ * - @c cantidades / @c capacidades: ocupación de cada segmento
+ *
+ * Además @c filas traduce ID internado -> índice denso (-1 si el ID no
+ * pertenece a esta tabla), de modo que buscar un sensor es O(1).
+ *
+ * Los segmentos y las columnas crecen duplicando su capacidad, por lo que
+ * agregar una lectura es O(1) amortizado y sin un nodo por lectura.
+ */
+template <typename T>
+class TablaColumnar {
+private:
+    uint32_t* ids;
+    T** valores;
+    int* cantidades;
+    int* capacidades;
+    int numSensores;
+    int capacidadSensores;
+    int* filas;
+    uint32_t capacidadFilas;
+
+public:
+    TablaColumnar()
+        : ids(nullptr), valores(nullptr), cantidades(nullptr), capacidades(nullptr),
+          numSensores(0), capacidadSensores(0), filas(nullptr), capacidadFilas(0) {}
+
+    ~TablaColumnar() {
+        for (int i = 0; i < numSensores; i++) {
+            delete[] valores[i];
+        }
+        delete[] ids;
+        delete[] valores;
+        delete[] cantidades;
+        delete[] capacidades;
+        delete[] filas;
+    }
+
+    // La tabla es dueña de sus arreglos; las vistas guardan punteros a ella
+    TablaColumnar(const TablaColumnar&) = delete;
+    TablaColumnar& operator=(const TablaColumnar&) = delete;
+
+    /**
+     * @brief Busca un sensor por su ID internado
+     * @return Índice denso o -1 si no existe
+     */
+    int buscar(uint32_t id) const {
+        return id < capacidadFilas ? filas[id] : -1;
+    }
+
+    /**
+     * @brief Da de alta un sensor sin lecturas
+     * @param id ID internado (TablaSimbolos) que no esté ya en la tabla
+     * @return Índice denso del nuevo sensor
+     */
+    int agregarSensor(uint32_t id) {
+        if (numSensores == capacidadSensores) {
+            crecerColumnas();
+        }
+        if (id >= capacidadFilas) {
+            crecerFilas(id);
+        }
+        int indice = numSensores++;
+        ids[indice] = id;
+        filas[id] = indice;
+        valores[indice] = nullptr;
+        cantidades[indice] = 0;
+        capacidades[indice] = 0;
+        return indice;
+    }
+
+    /**
+     * @brief Agrega una lectura al segmento del sensor @p indice
+     */
+    void agregarLectura(int indice, T valor) {
+        if (cantidades[indice] == capacidades[indice]) {
+            crecerSegmento(indice);
+        }
+        valores[indice][cantidades[indice]++] = valor;
+    }
+
+    int getNumSensores() const { return numSensores; }
+    uint32_t getId(int indice) const { return ids[indice]; }
+    const char* getNombre(int indice) const { return TablaSimbolos::global().nombre(ids[indice]); }
+    int getCantidad(int indice) const { return cantidades[indice]; }
+
+    /**
+     * @brief Segmento contiguo de lecturas del sensor @p indice
+     */
+    const T* getValores(int indice) const { return valores[indice]; }
+
+    /**
+     * @brief Bytes reservados por el segmento del sensor @p indice
+     * @details Incluye la capacidad sin usar y la cabecera del asignador
+     */
+    size_t getBytesSegmento(int indice) const {
+        return MemoriaHeap::costo(valores[indice], sizeof(T) * capacidades[indice]);
+    }
+
+    /**
+     * @brief Total de lecturas de todos los sensores de la tabla
+     */
+    long long getTotalLecturas() const {
+        long long total = 0;
+        for (int i = 0; i < numSensores; i++) {
+            total += cantidades[i];
+        }
+        return total;
+    }
+
+    /**
+     * @brief Mínimo de todas las lecturas de la tabla
+     * @param minimo Resultado (sin modificar si no hay lecturas)
+     * @return false si la tabla no tiene lecturas
+     */
+    bool minimoFlota(T& minimo) const {
+        bool hay = false;
+        for (int i = 0; i < numSensores; i++) {
+            const T* v = valores[i];
+            int n = cantidades[i];
+            for (int k = 0; k < n; k++) {
+                if (!hay || v[k] < minimo) {
+                    minimo = v[k];
+                    hay = true;
+                }
+            }
+        }
+        return hay;
+    }
+
+    /**
+     * @brief Promedio de todas las lecturas de la tabla
+     * @return false si la tabla no tiene lecturas
+     */
+    bool promedioFlota(double& promedio) const {
+        double suma = 0.0;
+        long long n = 0;
+        for (int i = 0; i < numSensores; i++) {
+            const T* v = valores[i];
+            int cantidad = cantidades[i];
+            for (int k = 0; k < cantidad; k++) {
+                suma += v[k];
+            }
+            n += cantidad;
+        }
+        if (n == 0) {
+            return false;
+        }
+        promedio = suma / n;
+        return true;
+    }
+
+private:
+    void crecerColumnas() {
+        int nueva = capacidadSensores == 0 ? 16 : capacidadSensores * 2;
+        uint32_t* nuevosIds = new uint32_t[nueva];
+        T** nuevosValores = new T*[nueva];
+        int* nuevasCantidades = new int[nueva];
+        int* nuevasCapacidades = new int[nueva];
+        if (numSensores > 0) {
+            std::memcpy(nuevosIds, ids, sizeof(uint32_t) * numSensores);
+            std::memcpy(nuevosValores, valores, sizeof(T*) * numSensores);
+            std::memcpy(nuevasCantidades, cantidades, sizeof(int) * numSensores);
+            std::memcpy(nuevasCapacidades, capacidades, sizeof(int) * numSensores);
+        }
+        delete[] ids;
+        delete[] valores;
+        delete[] cantidades;
+        delete[] capacidades;
+        ids = nuevosIds;
+        valores = nuevosValores;
+        cantidades = nuevasCantidades;
+        capacidades = nuevasCapacidades;
+        capacidadSensores = nueva;
+    }
+
+    // Amplía el índice ID -> fila hasta cubrir @p id (los IDs son densos)
+    void crecerFilas(uint32_t id) {
+        uint32_t nueva = capacidadFilas == 0 ? 64 : capacidadFilas;
+        while (nueva <= id) {
+            nueva *= 2;
+        }
+        int* nuevasFilas = new int[nueva];
+        for (uint32_t i = 0; i < nueva; i++) {
+            nuevasFilas[i] = i < capacidadFilas ? filas[i] : -1;
+        }
+        delete[] filas;
+        filas = nuevasFilas;
+        capacidadFilas = nueva;
+    }
+
+    void crecerSegmento(int indice) {
+        int nueva = capacidades[indice] == 0 ? 8 : capacidades[indice] * 2;
+        T* segmento = new T[nueva];
+        if (cantidades[indice] > 0) {
+            std::memcpy(segmento, valores[indice], sizeof(T) * cantidades[indice]);
+        }
+        delete[] valores[indice];
+        valores[indice] = segmento;
+        capacidades[indice] = nueva;
+    }
+};
+
+/**
+ * @class VistaSensorColumnar
+ * @brief Adaptador SensorBase sobre una fila de TablaColumnar
+ * @tparam Sensor Instanciación de SensorTipado cuyo tipo representa la vista
+ *
+ * @details
+ * No posee lecturas: guarda la tabla y el índice denso. Permite que el
+ * código escrito contra SensorBase (procesamiento polimórfico, métricas,
+ * imprimirInfo) funcione sin cambios sobre el almacén columnar. El
+ * procesamiento usa Sensor::procesarSegmento, así que la vista y el
+ * sensor de lista aplican la misma política. Destruir la vista no
+ * modifica la tabla.
+ */
+template <typename Sensor>
+class VistaSensorColumnar : public SensorBase {
+private:
+    typedef typename Sensor::Valor Valor;
+
+    const TablaColumnar<Valor>* tabla;
+    int indice;
+
+public:
+    VistaSensorColumnar(const TablaColumnar<Valor>* t, int idx)
+        : SensorBase(t->getNombre(idx)), tabla(t), indice(idx) {}
+
+    void procesarLectura() override {
+        if (tabla->getCantidad(indice) == 0) {
+            std::cout << "[Vista " << getNombre() << "] No hay lecturas para procesar" << std::endl;
+            return;
+        }
+        Sensor::procesarSegmento(tabla->getValores(indice), tabla->getCantidad(indice));
+    }
+
+    void imprimirInfo() const override {
+        std::cout << "\n=== Información del Sensor ===" << std::endl;
+        std::cout << "Tipo: " << Sensor::MagnitudSensor::nombre()
+                  << " (almacén columnar)" << std::endl;
+        std::cout << "ID: " << getNombre() << std::endl;
+        std::cout << "Índice denso: " << indice << std::endl;
+        std::cout << "Lecturas almacenadas: " << tabla->getCantidad(indice) << std::endl;
+        std::cout << "Memoria: " << getBytesMemoria() << " bytes (segmento contiguo)" << std::endl;
+        std::cout << "==============================\n" << std::endl;
+    }
+
+    int getNumLecturas() const override {
+        return tabla->getCantidad(indice);
+    }
+
+    char getTipo() const override {
+        return Sensor::TIPO;
+    }
+
+    void acumularLecturas(AgregadoLecturas& parcial) const override {
+        const Valor* valores = tabla->getValores(indice);
+        int n = tabla->getCantidad(indice);
+        for (int i = 0; i < n; i++) {
+            parcial.agregar(valores[i]);
+        }
+    }
+
+    size_t getBytesMemoria() const override {
+        return MemoriaHeap::estimar(sizeof(*this)) + tabla->getBytesSegmento(indice);
+    }
+
+    // El segmento ya es contiguo; la vista no modifica la tabla
+    void compactar() override {}
+
+    // El almacén columnar no aplica presupuestos por sensor
+    bool excedePresupuesto() const override {
+        return false;
+    }
+
+    int getIndice() const {
+        return indice;
+    }
+};
+
+/**
+ * @class AlmacenColumnar
+ * @brief Almacén de flota con una tabla columnar por tipo de sensor
+ *
+ * Ejemplo de uso:
+ * @code
+ * AlmacenColumnar almacen;
+ * registrarLectura(&almacen, lectura);
+ * almacen.imprimirAgregadosFlota();
+ * almacen.crearVistas(listaGestion);   // acceso vía SensorBase*
+ * @endcode
+ */
+class AlmacenColumnar {
+private:
+    TablaColumnar<float> temperaturas;
+    TablaColumnar<int> presiones;
+    TablaColumnar<double> vibraciones;
+
+public:
+    /**
+     * @brief Agrega una lectura válida, dando de alta el sensor si no existe
+     * @param lectura Lectura con resultado == ResultadoParseo::Valida
+     * @param llegadaNs Llegada al puerto, para la latencia de alertas (0 = sin marca)
+     * @details Si el ID ya existe con otro tipo, la lectura se descarta
+     *          igual que en la lista de gestión.
+     */
+    void registrar(const LecturaArduino& lectura, uint64_t llegadaNs = 0) {
+        uint32_t simbolo = lectura.simbolo != TablaSimbolos::SIN_ID
+                               ? lectura.simbolo
+                               : TablaSimbolos::global().internar(lectura.id);
+        if (lectura.tipo == 'T') {
+            registrarEn<SensorTemperatura>(temperaturas, simbolo, lectura.temperatura, llegadaNs);
+        } else if (lectura.tipo == 'P') {
+            registrarEn<SensorPresion>(presiones, simbolo, lectura.presion, llegadaNs);
+        } else {
+            registrarEn<SensorVibracion>(vibraciones, simbolo, lectura.vibracion, llegadaNs);
+        }
+    }
+
+    const TablaColumnar<float>& getTemperaturas() const { return temperaturas; }
+    const TablaColumnar<int>& getPresiones() const { return presiones; }
+    const TablaColumnar<double>& getVibraciones() const { return vibraciones; }
+
+    int getNumSensores() const {
+        return temperaturas.getNumSensores() + presiones.getNumSensores() +
+               vibraciones.getNumSensores();
+    }
+
+    /**
+     * @brief Inserta en @p lista una vista SensorBase por cada sensor
+     * @details Las vistas quedan indexadas (ListaGeneral::buscarPorId) y
+     *          deben liberarse (delete) antes que el almacén.
+     */
+    void crearVistas(ListaGeneral* lista) const {
+        for (int i = 0; i < temperaturas.getNumSensores(); i++) {
+            lista->insertarAlFinal(new VistaSensorColumnar<SensorTemperatura>(&temperaturas, i));
+        }
+        for (int i = 0; i < presiones.getNumSensores(); i++) {
+            lista->insertarAlFinal(new VistaSensorColumnar<SensorPresion>(&presiones, i));
+        }
+        for (int i = 0; i < vibraciones.getNumSensores(); i++) {
+            lista->insertarAlFinal(new VistaSensorColumnar<SensorVibracion>(&vibraciones, i));
+        }
+    }
+
+    /**
+     * @brief Imprime los agregados de toda la flota (recorridos lineales)
+     */
+    void imprimirAgregadosFlota() const {
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << "\n=== Agregados de la Flota (almacén columnar) ===" << std::endl;
+        std::cout << "Sensores de temperatura: " << temperaturas.getNumSensores()
+                  << " (" << temperaturas.getTotalLecturas() << " lecturas)" << std::endl;
+        std::cout << "Sensores de presión:     " << presiones.getNumSensores()
+                  << " (" << presiones.getTotalLecturas() << " lecturas)" << std::endl;
+        std::cout << "Sensores de vibración:   " << vibraciones.getNumSensores()
+                  << " (" << vibraciones.getTotalLecturas() << " lecturas)" << std::endl;
+
+        float minimo;
+        double promedio;
+        if (temperaturas.minimoFlota(minimo) && temperaturas.promedioFlota(promedio)) {
+            std::cout << "Temperatura mínima:      " << std::fixed << std::setprecision(1)
+                      << minimo << " °C" << std::endl;
+            std::cout << "Temperatura promedio:    " << std::setprecision(2)
+                      << promedio << " °C" << std::endl;
+        }
+        int minimoPresion;
+        if (presiones.minimoFlota(minimoPresion) && presiones.promedioFlota(promedio)) {
+            std::cout << "Presión mínima:          " << minimoPresion << " Pa" << std::endl;
+            std::cout << "Presión promedio:        " << std::fixed << std::setprecision(2)
+                      << promedio << " Pa" << std::endl;
+        }
+        double minimoVibracion;
+        if (vibraciones.minimoFlota(minimoVibracion) && vibraciones.promedioFlota(promedio)) {
+            std::cout << "Vibración mínima:        " << std::fixed << std::setprecision(3)
+                      << minimoVibracion << " mm/s" << std::endl;
+            std::cout << "Vibración promedio:      " << promedio << " mm/s" << std::endl;
+        }
+        std::cout << "================================================\n" << std::endl;
+        std::cout.flags(formato);
+        std::cout.precision(precision);
+    }
+private:
+    bool existe(uint32_t simbolo) const {
+        return temperaturas.buscar(simbolo) >= 0 || presiones.buscar(simbolo) >= 0 ||
+               vibraciones.buscar(simbolo) >= 0;
+    }
+
+    // Alta (si hace falta) e inserción en la tabla del tipo de @p Sensor
+    template <typename Sensor>
+    void registrarEn(TablaColumnar<typename Sensor::Valor>& tabla, uint32_t simbolo,
+                     typename Sensor::Valor valor, uint64_t llegadaNs) {
+        int indice = tabla.buscar(simbolo);
+        if (indice < 0) {
+            if (existe(simbolo)) {
+                return;
+            }
+            indice = tabla.agregarSensor(simbolo);
+        }
+        tabla.agregarLectura(indice, valor);
+        Metricas::incrementar(Sensor::MagnitudSensor::CONTADOR);
+        MotorReglas::global().evaluar(simbolo, static_cast<float>(valor), llegadaNs);
+        ExportadorLecturas& exportador = ExportadorLecturas::global();
+        if (exportador.estaActivo()) {
+            exportador.registrar(simbolo, Sensor::TIPO, valor);
+        }
+    }
+};
+
+/**
+ * @brief Destino de ingesta columnar (misma firma que la lista de gestión)
+ */
+inline void registrarLectura(AlmacenColumnar* almacen, const LecturaArduino& lectura,
+                             uint64_t llegadaNs = 0) {
+    almacen->registrar(lectura, llegadaNs);
+}
+
+#endif // ALMACENCOLUMNAR_H
@@ -0,0 +1,180 @@
+/**
+ * @file ArnesCarga.h
+ * @brief Arnés de rendimiento extremo a extremo para la ruta de ingesta
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Conecta GeneradorCarga con SerialPort y procesarLineaArduino() para
+ * medir la tasa sostenida de lecturas por segundo y los percentiles de
+ * latencia desde que los bytes de la línea (o de la trama binaria) llegan
+ * a SerialPort hasta que la lectura queda insertada.
+ */
+
+#ifndef ARNESCARGA_H
+#define ARNESCARGA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "ExportadorLecturas.h"
+#include "GeneradorCarga.h"
+#include "IngestaArduino.h"
+#include "Metricas.h"
+#include "MotorReglas.h"
+#include "SalidaSilenciada.h"
+#include "SerialPort.h"
+
+/**
+ * @struct ResultadoCarga
+ * @brief Resumen de una corrida del arnés
+ */
+struct ResultadoCarga {
+    unsigned long long lineasEmitidas;   ///< Líneas escritas por el generador
+    unsigned long long lineasLeidas;     ///< Líneas (o tramas) entregadas por SerialPort
+    unsigned long long lecturasValidas;  ///< Líneas que produjeron una lectura
+    double segundos;                     ///< Duración efectiva de la corrida
+    double lecturasPorSegundo;           ///< lecturasValidas / segundos
+    uint64_t p50Ns;                      ///< Mediana de latencia
+    uint64_t p90Ns;                      ///< Percentil 90
+    uint64_t p99Ns;                      ///< Percentil 99
+    uint64_t p999Ns;                     ///< Percentil 99.9
+    uint64_t maxNs;                      ///< Peor latencia observada
+
+    ResultadoCarga()
+        : lineasEmitidas(0), lineasLeidas(0), lecturasValidas(0), segundos(0.0),
+          lecturasPorSegundo(0.0), p50Ns(0), p90Ns(0), p99Ns(0), p999Ns(0), maxNs(0) {}
+
+    void imprimir() const {
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << "\n=== Resultado de la Prueba de Carga ===" << std::endl;
+        std::cout << "Duración:            " << std::fixed << std::setprecision(2)
+                  << segundos << " s" << std::endl;
+        std::cout << "Líneas emitidas:     " << lineasEmitidas << std::endl;
+        std::cout << "Líneas leídas:       " << lineasLeidas << std::endl;
+        std::cout << "Lecturas válidas:    " << lecturasValidas << std::endl;
+        std::cout << "Tasa sostenida:      " << std::setprecision(0)
+                  << lecturasPorSegundo << " lecturas/s" << std::endl;
+        std::cout << "Latencia p50/p90:    " << p50Ns << " / " << p90Ns << " ns" << std::endl;
+        std::cout << "Latencia p99/p99.9:  " << p99Ns << " / " << p999Ns << " ns" << std::endl;
+        std::cout << "Latencia máxima:     " << maxNs << " ns" << std::endl;
+        std::cout << "=======================================\n" << std::endl;
+        std::cout.flags(formato);
+        std::cout.precision(precision);
+    }
+};
+
+/**
+ * @class ArnesCarga
+ * @brief Ejecuta el generador contra la ruta de ingesta real
+ *
+ * @details
+ * La salida de consola se silencia durante la corrida para medir la
+ * ingesta y no la terminal. Las latencias se guardan exactas en un
+ * arreglo circular con las últimas MAX_MUESTRAS lecturas válidas.
+ */
+class ArnesCarga {
+public:
+    static const int MAX_MUESTRAS = 1 << 20;
+
+    /**
+     * @brief Corre una prueba de carga
+     * @param config Parámetros del generador
+     * @param duracionSegundos Tiempo de medición
+     * @param lista Lista de gestión donde se insertan las lecturas
+     * @param resultado Resumen de la corrida
+     * @return false si no se pudo crear o abrir el pseudo-terminal
+     */
+    static bool ejecutar(const ConfigGenerador& config, double duracionSegundos,
+                         ListaGeneral* lista, ResultadoCarga& resultado) {
+        GeneradorCarga generador(config);
+        SerialPort puerto;
+        if (!generador.crear() || !puerto.abrir(generador.getRutaEsclavo(), 115200, false)) {
+            return false;
+        }
+
+        puerto.setTareaPeriodica(static_cast<int>(MotorReglas::PERIODO_INACTIVIDAD_NS / 1000000ULL),
+                                 []() {
+            uint64_t ahora = Metricas::ahoraNs();
+            MotorReglas::global().revisarInactividad(ahora);
+            ExportadorLecturas::global().entregarVencido(ahora, MotorReglas::PERIODO_INACTIVIDAD_NS);
+        });
+
+        uint64_t* muestras = new uint64_t[MAX_MUESTRAS];
+        unsigned long long numMuestras = 0;
+        std::string linea;
+        uint64_t duracionNs = static_cast<uint64_t>(duracionSegundos * 1e9);
+
+        uint64_t inicio;
+        uint64_t fin;
+        {
+            SalidaSilenciada silencio;
+            generador.iniciar();
+            inicio = Metricas::ahoraNs();
+            fin = inicio;
+
+            if (config.binario) {
+                DecodificadorBinario decodificador;
+                unsigned char bytes[SerialPort::TAMANIO_BUFFER];
+                size_t n;
+                while (fin - inicio < duracionNs && (n = puerto.leerBytes(bytes, sizeof(bytes))) > 0) {
+                    uint64_t t0 = puerto.getMarcaLlegada();
+                    decodificador.alimentar(bytes, n, [&](const TramaBinaria& trama) {
+                        procesarTramaBinaria(lista, trama, t0);
+                        muestras[numMuestras % MAX_MUESTRAS] = Metricas::ahoraNs() - t0;
+                        numMuestras++;
+                    });
+                    fin = Metricas::ahoraNs();
+                }
+                resultado.lineasLeidas = decodificador.getTramasValidas() +
+                                         decodificador.getTramasCorruptas();
+                resultado.lecturasValidas = decodificador.getTramasValidas();
+            } else {
+                while (fin - inicio < duracionNs && puerto.leerLinea(linea)) {
+                    uint64_t t0 = puerto.getMarcaLlegada();
+                    resultado.lineasLeidas++;
+                    if (procesarLineaArduino(lista, linea, t0)) {
+                        fin = Metricas::ahoraNs();
+                        muestras[numMuestras % MAX_MUESTRAS] = fin - t0;
+                        numMuestras++;
+                        resultado.lecturasValidas++;
+                    } else {
+                        fin = Metricas::ahoraNs();
+                    }
+                }
+            }
+
+            generador.detener();
+            puerto.cerrar();
+        }
+
+        resultado.lineasEmitidas = generador.getLineasEmitidas();
+        resultado.segundos = static_cast<double>(fin - inicio) / 1e9;
+        if (resultado.segundos > 0.0) {
+            resultado.lecturasPorSegundo = resultado.lecturasValidas / resultado.segundos;
+        }
+
+        int n = static_cast<int>(std::min<unsigned long long>(numMuestras, MAX_MUESTRAS));
+        if (n > 0) {
+            std::sort(muestras, muestras + n);
+            resultado.p50Ns = muestras[percentil(n, 0.50)];
+            resultado.p90Ns = muestras[percentil(n, 0.90)];
+            resultado.p99Ns = muestras[percentil(n, 0.99)];
+            resultado.p999Ns = muestras[percentil(n, 0.999)];
+            resultado.maxNs = muestras[n - 1];
+        }
+        delete[] muestras;
+        return true;
+    }
+
+private:
+    static int percentil(int n, double p) {
+        int idx = static_cast<int>(p * n);
+        return idx < n ? idx : n - 1;
+    }
+};
+
+#endif // ARNESCARGA_H
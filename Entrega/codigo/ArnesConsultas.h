@@ -0,0 +1,149 @@
+/**
+ * @file ArnesConsultas.h
+ * @brief Medición de las consultas de flota con distinta cantidad de hilos
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Construye una flota sintética (por defecto 10 000 sensores con 10 000
+ * lecturas cada uno) y ejecuta tres consultas representativas con 1, 2,
+ * 4, ... hilos hasta los núcleos disponibles, reportando tiempo y
+ * lecturas reducidas por segundo.
+ */
+
+#ifndef ARNESCONSULTAS_H
+#define ARNESCONSULTAS_H
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include "AlmacenColumnar.h"
+#include "ConsultasFlota.h"
+#include "IngestaArduino.h"
+#include "SalidaSilenciada.h"
+
+/**
+ * @class ArnesConsultas
+ * @brief Flota sintética + tabla de tiempos por consulta e hilos
+ *
+ * @details
+ * Con el almacén columnar la lista contiene vistas sobre segmentos
+ * contiguos (unos 4 bytes por lectura). Con la lista de gestión cada
+ * lectura es un nodo, por lo que 10k x 10k requiere varios GB; para ese
+ * almacén conviene reducir --sensores o --lecturas.
+ */
+class ArnesConsultas {
+public:
+    /**
+     * @brief Construye la flota y mide las consultas
+     * @param numSensores Sensores (mitad T, mitad P)
+     * @param lecturasPorSensor Lecturas por sensor
+     * @param columnar true para AlmacenColumnar, false para la lista de gestión
+     * @param maxHilos Máximo de hilos a probar (0 = núcleos disponibles)
+     */
+    static void ejecutar(int numSensores, int lecturasPorSensor, bool columnar, int maxHilos) {
+        if (maxHilos <= 0) {
+            maxHilos = static_cast<int>(std::thread::hardware_concurrency());
+        }
+        if (maxHilos <= 0) {
+            maxHilos = 1;
+        }
+
+        ListaGeneral* lista;
+        AlmacenColumnar* almacen = columnar ? new AlmacenColumnar() : nullptr;
+        std::cout << "[Consultas] Construyendo " << numSensores << " sensores x "
+                  << lecturasPorSensor << " lecturas ("
+                  << (columnar ? "almacén columnar" : "lista de gestión") << ")..." << std::endl;
+        uint64_t inicioNs = Metricas::ahoraNs();
+        {
+            SalidaSilenciada silencio;
+            lista = new ListaGeneral();
+            construirFlota(numSensores, lecturasPorSensor, lista, almacen);
+        }
+        std::cout << "[Consultas] Flota lista en " << std::fixed << std::setprecision(2)
+                  << (Metricas::ahoraNs() - inicioNs) / 1e9 << " s" << std::endl;
+
+        Consulta consultas[3];
+        const char* descripciones[3] = {
+            "Presión promedio, prefijo P-1",
+            "Temperatura mínima por grupo (4 caracteres)",
+            "Toda la flota"
+        };
+        consultas[0].prefijo = "P-1";
+        consultas[0].tipo = 'P';
+        consultas[1].tipo = 'T';
+        consultas[1].largoGrupo = 4;
+
+        std::ios::fmtflags formato = std::cout.flags();
+        for (int c = 0; c < 3; c++) {
+            std::cout << "\n--- " << descripciones[c] << " ---" << std::endl;
+            for (int hilos = 1; ; hilos *= 2) {
+                if (hilos > maxHilos) {
+                    hilos = maxHilos;
+                }
+                consultas[c].hilos = hilos;
+                ResultadoConsulta resultado;
+                ConsultasFlota::ejecutar(lista, consultas[c], resultado);
+                double lecturasPorSegundo = resultado.segundos > 0.0
+                                                ? resultado.total.cuenta / resultado.segundos : 0.0;
+                std::cout << "  " << std::setw(3) << resultado.hilosUsados << " hilos: "
+                          << std::setprecision(2) << std::setw(9) << resultado.segundos * 1000.0
+                          << " ms  " << std::setprecision(0) << std::setw(12) << lecturasPorSegundo
+                          << " lecturas/s  (" << resultado.sensoresConsultados << " sensores, "
+                          << resultado.total.cuenta << " lecturas, promedio "
+                          << std::setprecision(2) << resultado.total.promedio() << ", mínimo "
+                          << resultado.total.minimo << ")" << std::endl;
+                if (hilos >= maxHilos) {
+                    break;
+                }
+            }
+        }
+        std::cout << std::endl;
+        std::cout.flags(formato);
+
+        {
+            SalidaSilenciada silencio;
+            lista->iterar([](SensorBase* sensor) {
+                delete sensor;
+            });
+            delete lista;
+            delete almacen;
+        }
+    }
+
+private:
+    static void construirFlota(int numSensores, int lecturasPorSensor, ListaGeneral* lista,
+                               AlmacenColumnar* almacen) {
+        std::mt19937 rng(7);
+        std::normal_distribution<float> temperatura(22.0f, 3.0f);
+        std::uniform_int_distribution<int> presion(95000, 105000);
+        LecturaArduino lectura;
+        lectura.resultado = ResultadoParseo::Valida;
+        lectura.tienePunto = false;
+
+        for (int s = 0; s < numSensores; s++) {
+            lectura.tipo = (s % 2 == 0) ? 'T' : 'P';
+            std::snprintf(lectura.id, sizeof(lectura.id), "%c-%d", lectura.tipo, s / 2);
+            lectura.simbolo = TablaSimbolos::global().internar(lectura.id);
+            for (int k = 0; k < lecturasPorSensor; k++) {
+                if (lectura.tipo == 'T') {
+                    lectura.temperatura = temperatura(rng);
+                } else {
+                    lectura.presion = presion(rng);
+                }
+                if (almacen != nullptr) {
+                    registrarLectura(almacen, lectura);
+                } else {
+                    registrarLectura(lista, lectura);
+                }
+            }
+        }
+        if (almacen != nullptr) {
+            almacen->crearVistas(lista);
+        }
+    }
+};
+
+#endif // ARNESCONSULTAS_H
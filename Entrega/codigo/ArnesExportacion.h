@@ -0,0 +1,130 @@
+/**
+ * @file ArnesExportacion.h
+ * @brief Prueba de carga con la exportación de lecturas apagada, en CSV y en binario
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Corre ArnesCarga tres veces con la misma configuración y compara la
+ * tasa sostenida y la latencia de ingesta con y sin ExportadorLecturas,
+ * para verificar que escribir a disco no frena la ingesta.
+ */
+
+#ifndef ARNESEXPORTACION_H
+#define ARNESEXPORTACION_H
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "ArnesCarga.h"
+#include "ExportadorLecturas.h"
+#include "IngestaArduino.h"
+#include "SalidaSilenciada.h"
+
+/**
+ * @class ArnesExportacion
+ * @brief Tabla de rendimiento de ingesta por modo de exportación
+ *
+ * @details
+ * Cada corrida usa una lista de gestión nueva. La exportación se configura
+ * como en la ingesta en vivo (sin esperar al escritor), así que si el
+ * disco no da abasto se ven lecturas descartadas en lugar de una caída de
+ * la tasa. Los archivos generados se borran al terminar salvo que se pida
+ * conservarlos.
+ */
+class ArnesExportacion {
+public:
+    /**
+     * @brief Ejecuta las tres corridas e imprime la comparación
+     * @param numSensores Sensores simulados
+     * @param segundos Duración de cada corrida
+     * @param exportacion Prefijo y rotación de los archivos (formato y espera se fijan aquí)
+     * @param conservar false para borrar los archivos al terminar
+     * @return false si no se pudo iniciar el generador o el exportador
+     */
+    static bool ejecutar(int numSensores, double segundos, const ConfigExportacion& exportacion,
+                         bool conservar) {
+        ConfigGenerador generador;
+        generador.numSensores = numSensores;
+        generador.lecturasPorSegundo = 0.0;
+
+        const char* modos[3] = {"sin exportar", "CSV", "binario"};
+        ResultadoCarga resultados[3];
+        uint64_t escritas[3] = {0, 0, 0};
+        uint64_t descartadas[3] = {0, 0, 0};
+        uint64_t bytes[3] = {0, 0, 0};
+        int archivos[3] = {0, 0, 0};
+
+        std::cout << "[Exportación] " << numSensores << " sensores, " << segundos
+                  << " s por corrida, prefijo " << exportacion.prefijo << std::endl;
+        for (int m = 0; m < 3; m++) {
+            ExportadorLecturas& exportador = ExportadorLecturas::global();
+            int primerArchivo = exportador.getUltimoArchivo() + 1;
+            if (m > 0) {
+                ConfigExportacion config = exportacion;
+                config.formato = (m == 1) ? FormatoExportacion::CSV : FormatoExportacion::Binario;
+                config.esperarEscritor = false;
+                if (!exportador.iniciar(config)) {
+                    return false;
+                }
+            }
+
+            ListaGeneral* lista;
+            {
+                SalidaSilenciada silencio;
+                lista = new ListaGeneral();
+            }
+            bool ok = ArnesCarga::ejecutar(generador, segundos, lista, resultados[m]);
+            if (m > 0) {
+                exportador.detener();
+                escritas[m] = exportador.getEscritas();
+                descartadas[m] = exportador.getDescartadas();
+                bytes[m] = exportador.getBytes();
+                archivos[m] = exportador.getArchivos();
+                if (!conservar) {
+                    for (int a = primerArchivo; a <= exportador.getUltimoArchivo(); a++) {
+                        std::remove(exportador.nombreArchivo(a).c_str());
+                    }
+                }
+            }
+            {
+                SalidaSilenciada silencio;
+                lista->iterar([](SensorBase* sensor) {
+                    delete sensor;
+                });
+                delete lista;
+            }
+            if (!ok) {
+                std::cout << "❌ No se pudo iniciar el generador de carga" << std::endl;
+                return false;
+            }
+            std::cout << "  " << modos[m] << ": " << std::fixed << std::setprecision(0)
+                      << resultados[m].lecturasPorSegundo << " lecturas/s" << std::endl;
+        }
+
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << "\n=== Ingesta con exportación ===" << std::endl;
+        std::cout << "Modo            Lecturas/s   Relativo   p50 ns   p99 ns   "
+                  << "Exportadas  Descartadas  Archivos      MiB" << std::endl;
+        for (int m = 0; m < 3; m++) {
+            double relativo = resultados[0].lecturasPorSegundo > 0.0
+                                  ? resultados[m].lecturasPorSegundo / resultados[0].lecturasPorSegundo
+                                  : 0.0;
+            std::cout << std::left << std::setw(14) << modos[m] << std::right << std::fixed
+                      << std::setprecision(0) << std::setw(12) << resultados[m].lecturasPorSegundo
+                      << std::setprecision(3) << std::setw(11) << relativo
+                      << std::setw(9) << resultados[m].p50Ns << std::setw(9) << resultados[m].p99Ns
+                      << std::setw(13) << escritas[m] << std::setw(13) << descartadas[m]
+                      << std::setw(10) << archivos[m] << std::setprecision(1) << std::setw(9)
+                      << bytes[m] / (1024.0 * 1024.0) << std::endl;
+        }
+        std::cout << "===============================\n" << std::endl;
+        std::cout.flags(formato);
+        std::cout.precision(precision);
+        return true;
+    }
+};
+
+#endif // ARNESEXPORTACION_H
@@ -0,0 +1,263 @@
+/**
+ * @file ArnesReglas.h
+ * @brief Medición del costo del motor de reglas sobre agregarLectura()
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Inserta el mismo flujo sintético de lecturas dos veces en una flota de
+ * sensores reales: primero sin reglas y luego con ellas. La diferencia
+ * entre ambas pasadas es el costo de evaluar las reglas por lectura.
+ *
+ * La latencia de las alertas se mide aparte, con las reglas cargadas y
+ * ArnesCarga empujando lecturas con picos por el pseudo-terminal a una
+ * tasa fija: el histograma LatenciaAlerta cubre entonces desde que los
+ * bytes llegan a SerialPort hasta que se emite la alerta.
+ */
+
+#ifndef ARNESREGLAS_H
+#define ARNESREGLAS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include "ArnesCarga.h"
+#include "GeneradorCarga.h"
+#include "IngestaArduino.h"
+#include "ListaSensor.h"
+#include "Metricas.h"
+#include "MotorReglas.h"
+#include "SalidaSilenciada.h"
+#include "SensorBase.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+/**
+ * @struct ResultadoReglas
+ * @brief Resumen de una corrida del arnés de reglas
+ */
+struct ResultadoReglas {
+    int numSensores;                    ///< Sensores de la flota (mitad T, mitad P)
+    unsigned long long numLecturas;     ///< Lecturas insertadas por pasada
+    int numReglas;                      ///< Reglas cargadas en la segunda pasada
+    double nsSinReglas;                 ///< Costo medio de agregarLectura sin reglas
+    double nsConReglas;                 ///< Costo medio de agregarLectura con reglas
+    unsigned long long alertas;         ///< Alertas emitidas en la segunda pasada
+    ResultadoCarga carga;               ///< Ingesta de la pasada bajo carga
+    unsigned long long alertasCarga;    ///< Alertas emitidas bajo carga
+    uint64_t p50Ns;                     ///< Mediana de latencia llegada → alerta (cota de cubeta)
+    uint64_t p99Ns;                     ///< Percentil 99 (cota de cubeta)
+    uint64_t p999Ns;                    ///< Percentil 99.9 (cota de cubeta)
+
+    ResultadoReglas()
+        : numSensores(0), numLecturas(0), numReglas(0), nsSinReglas(0.0), nsConReglas(0.0),
+          alertas(0), alertasCarga(0), p50Ns(0), p99Ns(0), p999Ns(0) {}
+
+    void imprimir() const {
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << "\n=== Resultado del Arnés de Reglas ===" << std::endl;
+        std::cout << "Sensores:               " << numSensores << std::endl;
+        std::cout << "Lecturas por pasada:    " << numLecturas << std::endl;
+        std::cout << "Reglas cargadas:        " << numReglas << std::endl;
+        std::cout << "agregarLectura sin reglas: " << std::fixed << std::setprecision(1)
+                  << nsSinReglas << " ns/lectura" << std::endl;
+        std::cout << "agregarLectura con reglas: " << nsConReglas << " ns/lectura ("
+                  << std::setprecision(0) << (nsConReglas > 0.0 ? 1e9 / nsConReglas : 0.0)
+                  << " lecturas/s)" << std::endl;
+        std::cout << "Costo de las reglas:    " << std::setprecision(1)
+                  << (nsConReglas - nsSinReglas) << " ns/lectura" << std::endl;
+        std::cout << "Alertas emitidas:       " << alertas << std::endl;
+        std::cout << "Bajo carga:             " << carga.lecturasValidas << " lecturas en "
+                  << std::setprecision(2) << carga.segundos << " s ("
+                  << std::setprecision(0) << carga.lecturasPorSegundo << " lecturas/s)" << std::endl;
+        std::cout << "Latencia de ingesta p50/p99: " << carga.p50Ns << " / " << carga.p99Ns
+                  << " ns" << std::endl;
+        std::cout << "Alertas bajo carga:     " << alertasCarga << std::endl;
+        std::cout << "Latencia llegada → alerta p50/p99/p99.9: <= " << p50Ns << " / " << p99Ns
+                  << " / " << p999Ns << " ns" << std::endl;
+        std::cout << "=====================================\n" << std::endl;
+        std::cout.flags(formato);
+        std::cout.precision(precision);
+    }
+};
+
+/**
+ * @class ArnesReglas
+ * @brief Mide el motor de reglas sobre la ruta real de inserción
+ *
+ * @details
+ * Las lecturas se generan antes de medir (temperaturas normales con
+ * 0.2 % de picos, presiones en Pa uniformes con 0.2 % fuera de rango), de modo
+ * que sólo se cronometra agregarLectura(). La pasada bajo carga usa
+ * GeneradorCarga con 1 % de picos sobre una lista de prueba que se libera
+ * al terminar. La consola se silencia durante la corrida.
+ */
+class ArnesReglas {
+public:
+    /**
+     * @brief Reglas usadas cuando no se indica un archivo
+     */
+    static const char* reglasPorDefecto() {
+        return "T-*  umbral      -10 45\n"
+               "T-*  cambio      15\n"
+               "T-*  ventana     3 10 0 40\n"
+               "P-*  umbral      90000 110000\n"
+               "P-*  ventana     4 16 95000 105000\n"
+               "*    inactividad 60\n";
+    }
+
+    /**
+     * @brief Corre las dos pasadas de costo y la pasada bajo carga
+     * @param numSensores Tamaño de la flota (>= 2)
+     * @param numLecturas Lecturas por pasada
+     * @param rutaReglas Archivo de reglas, o nullptr para reglasPorDefecto()
+     * @param tasa Lecturas por segundo de la pasada bajo carga (0 = sin límite)
+     * @param segundos Duración de la pasada bajo carga
+     * @param resultado Resumen de la corrida
+     * @return false si las reglas no se pudieron cargar o el generador no arrancó
+     */
+    static bool ejecutar(int numSensores, unsigned long long numLecturas,
+                         const char* rutaReglas, double tasa, double segundos,
+                         ResultadoReglas& resultado) {
+        MotorReglas& motor = MotorReglas::global();
+        resultado.numSensores = numSensores;
+        resultado.numLecturas = numLecturas;
+
+        int numTemperatura = numSensores / 2;
+        SensorTemperatura** temperaturas = new SensorTemperatura*[numTemperatura];
+        SensorPresion** presiones = new SensorPresion*[numSensores - numTemperatura];
+        int* sensores = new int[numLecturas];
+        float* valores = new float[numLecturas];
+
+        bool ok;
+        {
+            SalidaSilenciada silencio;
+            char nombre[16];
+            for (int i = 0; i < numTemperatura; i++) {
+                std::snprintf(nombre, sizeof(nombre), "T-%04d", i);
+                temperaturas[i] = new SensorTemperatura(nombre);
+            }
+            for (int i = 0; i < numSensores - numTemperatura; i++) {
+                std::snprintf(nombre, sizeof(nombre), "P-%04d", i);
+                presiones[i] = new SensorPresion(nombre);
+            }
+            generarLecturas(numSensores, numLecturas, sensores, valores);
+
+            motor.desactivar();
+            resultado.nsSinReglas = pasada(temperaturas, numTemperatura, presiones,
+                                           numLecturas, sensores, valores);
+
+            if (rutaReglas != nullptr) {
+                ok = motor.cargar(rutaReglas);
+            } else {
+                std::istringstream porDefecto(reglasPorDefecto());
+                ok = motor.cargar(porDefecto, "reglas por defecto");
+            }
+            if (ok) {
+                resultado.numReglas = motor.getNumReglas();
+                motor.setEco(false);
+                uint64_t alertasAntes = motor.getNumAlertas();
+                resultado.nsConReglas = pasada(temperaturas, numTemperatura, presiones,
+                                               numLecturas, sensores, valores);
+                resultado.alertas = motor.getNumAlertas() - alertasAntes;
+                ok = pasadaCarga(numSensores, tasa, segundos, resultado);
+                motor.setEco(true);
+            }
+            motor.desactivar();
+
+            for (int i = 0; i < numTemperatura; i++) {
+                delete temperaturas[i];
+            }
+            for (int i = 0; i < numSensores - numTemperatura; i++) {
+                delete presiones[i];
+            }
+        }
+
+        delete[] temperaturas;
+        delete[] presiones;
+        delete[] sensores;
+        delete[] valores;
+        return ok;
+    }
+
+private:
+    // Ingesta real a @p tasa con las reglas ya cargadas; toma del histograma
+    // LatenciaAlerta sólo lo observado durante esta pasada
+    static bool pasadaCarga(int numSensores, double tasa, double segundos,
+                            ResultadoReglas& resultado) {
+        MotorReglas& motor = MotorReglas::global();
+        ConfigGenerador config;
+        config.numSensores = numSensores;
+        config.lecturasPorSegundo = tasa;
+        config.proporcionPicos = 0.01;
+
+        ListaGeneral* lista = new ListaGeneral();
+        uint64_t alertasAntes = motor.getNumAlertas();
+        InstantaneaMetricas antes = Metricas::instantanea();
+        bool ok = ArnesCarga::ejecutar(config, segundos, lista, resultado.carga);
+        InstantaneaMetricas despues = Metricas::instantanea();
+        resultado.alertasCarga = motor.getNumAlertas() - alertasAntes;
+        lista->iterar([](SensorBase* sensor) {
+            delete sensor;
+        });
+        delete lista;
+        if (!ok) {
+            std::cerr << "Error: no se pudo iniciar el generador de carga" << std::endl;
+            return false;
+        }
+
+        int h = static_cast<int>(Histograma::LatenciaAlerta);
+        for (int i = 0; i < InstantaneaMetricas::NUM_CUBETAS; i++) {
+            despues.cubetas[h][i] -= antes.cubetas[h][i];
+        }
+        despues.cuenta[h] -= antes.cuenta[h];
+        resultado.p50Ns = despues.percentil(Histograma::LatenciaAlerta, 0.50);
+        resultado.p99Ns = despues.percentil(Histograma::LatenciaAlerta, 0.99);
+        resultado.p999Ns = despues.percentil(Histograma::LatenciaAlerta, 0.999);
+        return true;
+    }
+
+    // sensores[k] < numTemperatura es un sensor T; el resto, P
+    static void generarLecturas(int numSensores, unsigned long long numLecturas,
+                                int* sensores, float* valores) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> elegir(0, numSensores - 1);
+        std::uniform_real_distribution<double> u01(0.0, 1.0);
+        std::normal_distribution<double> temperatura(22.0, 3.0);
+        std::uniform_int_distribution<int> presion(95000, 105000);
+        int numTemperatura = numSensores / 2;
+        for (unsigned long long k = 0; k < numLecturas; k++) {
+            int s = elegir(rng);
+            bool pico = u01(rng) < 0.002;
+            sensores[k] = s;
+            if (s < numTemperatura) {
+                valores[k] = static_cast<float>(pico ? 60.0 : temperatura(rng));
+            } else {
+                valores[k] = static_cast<float>(pico ? 120000 : presion(rng));
+            }
+        }
+    }
+
+    // Devuelve el costo medio en ns por lectura
+    static double pasada(SensorTemperatura** temperaturas, int numTemperatura,
+                         SensorPresion** presiones, unsigned long long numLecturas,
+                         const int* sensores, const float* valores) {
+        uint64_t inicio = Metricas::ahoraNs();
+        for (unsigned long long k = 0; k < numLecturas; k++) {
+            int s = sensores[k];
+            if (s < numTemperatura) {
+                temperaturas[s]->agregarLectura(valores[k]);
+            } else {
+                presiones[s - numTemperatura]->agregarLectura(static_cast<int>(valores[k]));
+            }
+        }
+        uint64_t fin = Metricas::ahoraNs();
+        return numLecturas > 0 ? static_cast<double>(fin - inicio) / numLecturas : 0.0;
+    }
+};
+
+#endif // ARNESREGLAS_H
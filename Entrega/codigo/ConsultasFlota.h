@@ -0,0 +1,304 @@
+/**
+ * @file ConsultasFlota.h
+ * @brief Consultas agregadas sobre toda la flota con reducción en paralelo
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Responde preguntas como "presión promedio de los sensores con prefijo
+ * P-1" o "temperatura mínima por grupo" sobre la lista de gestión y
+ * devuelve un resultado estructurado en lugar de imprimir por sensor.
+ */
+
+#ifndef CONSULTASFLOTA_H
+#define CONSULTASFLOTA_H
+
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include "AgregadoLecturas.h"
+#include "ListaGeneral.h"
+#include "Metricas.h"
+#include "SensorBase.h"
+#include "TablaSimbolos.h"
+
+/**
+ * @struct Consulta
+ * @brief Filtro y agrupación de una consulta de flota
+ */
+struct Consulta {
+    const char* prefijo;   ///< Sólo sensores cuyo ID empieza así ("" = todos)
+    char tipo;             ///< 'T', 'P', 'V' o 0 para todos los tipos
+    int largoGrupo;        ///< Agrupar por los primeros N caracteres del ID (0 = sin grupos)
+    int hilos;             ///< Hilos de la reducción (0 = núcleos disponibles)
+
+    Consulta() : prefijo(""), tipo(0), largoGrupo(0), hilos(0) {}
+};
+
+/**
+ * @class ResultadoConsulta
+ * @brief Total y agregados por grupo de una consulta
+ *
+ * @details
+ * Los grupos se identifican por su clave (prefijo del ID) internada en
+ * una tabla propia, por lo que dos resultados con las mismas claves se
+ * combinan grupo a grupo con combinar().
+ */
+class ResultadoConsulta {
+private:
+    TablaSimbolos claves;
+    AgregadoLecturas* grupos;
+    int capacidadGrupos;
+
+public:
+    AgregadoLecturas total;      ///< Todas las lecturas seleccionadas
+    int sensoresConsultados;     ///< Sensores que pasaron el filtro
+    int hilosUsados;             ///< Hilos de la última reducción
+    double segundos;             ///< Duración de la última reducción
+
+    ResultadoConsulta()
+        : grupos(nullptr), capacidadGrupos(0), sensoresConsultados(0), hilosUsados(0),
+          segundos(0.0) {}
+
+    ~ResultadoConsulta() {
+        delete[] grupos;
+    }
+
+    ResultadoConsulta(const ResultadoConsulta&) = delete;
+    ResultadoConsulta& operator=(const ResultadoConsulta&) = delete;
+
+    friend class ConsultasFlota;
+
+    int getNumGrupos() const {
+        return static_cast<int>(claves.tamanio());
+    }
+
+    const char* getClave(int grupo) const {
+        return claves.nombre(static_cast<uint32_t>(grupo));
+    }
+
+    const AgregadoLecturas& getGrupo(int grupo) const {
+        return grupos[grupo];
+    }
+
+    /**
+     * @brief Índice del grupo con clave @p clave, creándolo vacío si no existe
+     */
+    int grupo(const char* clave) {
+        int indice = static_cast<int>(claves.internar(clave));
+        if (indice >= capacidadGrupos) {
+            int nueva = capacidadGrupos == 0 ? 16 : capacidadGrupos * 2;
+            AgregadoLecturas* mayor = new AgregadoLecturas[nueva];
+            for (int i = 0; i < capacidadGrupos; i++) {
+                mayor[i] = grupos[i];
+            }
+            delete[] grupos;
+            grupos = mayor;
+            capacidadGrupos = nueva;
+        }
+        return indice;
+    }
+
+    /**
+     * @brief Suma a este resultado otro calculado sobre sensores disjuntos
+     */
+    void combinar(const ResultadoConsulta& otro) {
+        total.combinar(otro.total);
+        sensoresConsultados += otro.sensoresConsultados;
+        for (int g = 0; g < otro.getNumGrupos(); g++) {
+            int indice = grupo(otro.getClave(g));
+            grupos[indice].combinar(otro.getGrupo(g));
+        }
+    }
+
+    void imprimir() const {
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << "\n=== Consulta de Flota ===" << std::endl;
+        std::cout << "Sensores: " << sensoresConsultados << "   Hilos: " << hilosUsados
+                  << "   Tiempo: " << std::fixed << std::setprecision(3)
+                  << segundos * 1000.0 << " ms" << std::endl;
+        imprimirFila("Total", total);
+        for (int g = 0; g < getNumGrupos(); g++) {
+            imprimirFila(getClave(g), grupos[g]);
+        }
+        std::cout << "=========================\n" << std::endl;
+        std::cout.flags(formato);
+        std::cout.precision(precision);
+    }
+
+private:
+    static void imprimirFila(const char* etiqueta, const AgregadoLecturas& a) {
+        std::cout << std::left << std::setw(12) << etiqueta << std::right
+                  << " n=" << a.cuenta;
+        if (!a.estaVacio()) {
+            std::cout << std::setprecision(2) << "  min=" << a.minimo << "  max=" << a.maximo
+                      << "  promedio=" << a.promedio();
+        }
+        std::cout << std::endl;
+    }
+};
+
+/**
+ * @class ConsultasFlota
+ * @brief Ejecuta consultas sobre la lista de gestión
+ *
+ * @details
+ * 1. Un recorrido secuencial de la lista aplica el filtro y asigna cada
+ *    sensor a su grupo (O(sensores), sin tocar las lecturas).
+ * 2. Los sensores seleccionados se reparten entre los hilos en tramos
+ *    contiguos con cantidades de lecturas similares.
+ * 3. Cada hilo reduce sus sensores con SensorBase::acumularLecturas()
+ *    sobre un arreglo privado de parciales por grupo.
+ * 4. Los parciales se combinan en el hilo llamador.
+ *
+ * @note La lista no debe modificarse mientras corre la consulta.
+ *
+ * Ejemplo de uso:
+ * @code
+ * Consulta c;
+ * c.prefijo = "P-1";
+ * c.tipo = 'P';
+ * ResultadoConsulta r;
+ * ConsultasFlota::ejecutar(listaGestion, c, r);
+ * double promedio = r.total.promedio();
+ * @endcode
+ */
+class ConsultasFlota {
+private:
+    // Tramo de sensores asignado a un hilo
+    struct TramoConsulta {
+        SensorBase* const* sensores;
+        const int* grupos;
+        int inicio;
+        int fin;
+        AgregadoLecturas* parciales;   // uno por grupo
+
+        // Un parcial por sensor: los parciales de hilos vecinos comparten
+        // línea de caché, así que sólo se escriben una vez por sensor
+        void reducir() {
+            for (int i = inicio; i < fin; i++) {
+                AgregadoLecturas sensor;
+                sensores[i]->acumularLecturas(sensor);
+                parciales[grupos[i]].combinar(sensor);
+            }
+        }
+    };
+
+public:
+    /**
+     * @brief Ejecuta @p consulta sobre @p lista
+     * @param lista Lista de gestión (sensores reales o vistas columnares)
+     * @param consulta Filtro y agrupación
+     * @param resultado Recibe el total y los grupos (se combina con lo que ya tenga)
+     */
+    static void ejecutar(const ListaGeneral* lista, const Consulta& consulta,
+                         ResultadoConsulta& resultado) {
+        uint64_t inicioNs = Metricas::ahoraNs();
+        int capacidad = lista->getTamanio();
+        SensorBase** seleccion = new SensorBase*[capacidad > 0 ? capacidad : 1];
+        int* grupos = new int[capacidad > 0 ? capacidad : 1];
+        long long* lecturas = new long long[capacidad > 0 ? capacidad : 1];
+        int numSeleccion = 0;
+        long long totalLecturas = 0;
+
+        // 1. Filtro y asignación de grupo
+        ResultadoConsulta local;
+        bool agrupar = consulta.largoGrupo > 0;
+        size_t largoPrefijo = std::strlen(consulta.prefijo);
+        lista->iterar([&](SensorBase* sensor) {
+            const char* nombre = sensor->getNombre();
+            if ((consulta.tipo != 0 && sensor->getTipo() != consulta.tipo) ||
+                std::strncmp(nombre, consulta.prefijo, largoPrefijo) != 0) {
+                return;
+            }
+            int g = 0;
+            if (agrupar) {
+                char clave[TablaSimbolos::LARGO_MAXIMO + 1];
+                size_t largo = std::strlen(nombre);
+                if (largo > static_cast<size_t>(consulta.largoGrupo)) {
+                    largo = static_cast<size_t>(consulta.largoGrupo);
+                }
+                std::memcpy(clave, nombre, largo);
+                clave[largo] = '\0';
+                g = local.grupo(clave);
+            }
+            seleccion[numSeleccion] = sensor;
+            grupos[numSeleccion] = g;
+            lecturas[numSeleccion] = sensor->getNumLecturas();
+            totalLecturas += lecturas[numSeleccion];
+            numSeleccion++;
+        });
+
+        // 2. Tramos con cantidades de lecturas similares
+        int numHilos = consulta.hilos > 0 ? consulta.hilos
+                                          : static_cast<int>(std::thread::hardware_concurrency());
+        if (numHilos <= 0) {
+            numHilos = 1;
+        }
+        if (numHilos > numSeleccion) {
+            numHilos = numSeleccion > 0 ? numSeleccion : 1;
+        }
+        int numGrupos = agrupar && local.getNumGrupos() > 0 ? local.getNumGrupos() : 1;
+        AgregadoLecturas* parciales = new AgregadoLecturas[numHilos * numGrupos];
+        TramoConsulta* tramos = new TramoConsulta[numHilos];
+        int siguiente = 0;
+        long long acumuladas = 0;
+        for (int t = 0; t < numHilos; t++) {
+            long long objetivo = totalLecturas * (t + 1) / numHilos;
+            int fin = siguiente;
+            while (fin < numSeleccion && (acumuladas < objetivo || t == numHilos - 1)) {
+                acumuladas += lecturas[fin];
+                fin++;
+            }
+            tramos[t].sensores = seleccion;
+            tramos[t].grupos = grupos;
+            tramos[t].inicio = siguiente;
+            tramos[t].fin = fin;
+            tramos[t].parciales = parciales + t * numGrupos;
+            siguiente = fin;
+        }
+
+        // 3. Reducción en paralelo
+        if (numHilos == 1) {
+            tramos[0].reducir();
+        } else {
+            std::thread* hilos = new std::thread[numHilos - 1];
+            for (int t = 1; t < numHilos; t++) {
+                hilos[t - 1] = std::thread(&TramoConsulta::reducir, &tramos[t]);
+            }
+            tramos[0].reducir();
+            for (int t = 0; t < numHilos - 1; t++) {
+                hilos[t].join();
+            }
+            delete[] hilos;
+        }
+
+        // 4. Combinación de parciales
+        for (int g = 0; g < numGrupos; g++) {
+            AgregadoLecturas suma;
+            for (int t = 0; t < numHilos; t++) {
+                suma.combinar(parciales[t * numGrupos + g]);
+            }
+            if (agrupar && g < local.getNumGrupos()) {
+                local.grupos[g] = suma;
+            }
+            local.total.combinar(suma);
+        }
+        local.sensoresConsultados = numSeleccion;
+
+        resultado.combinar(local);
+        resultado.hilosUsados = numHilos;
+        resultado.segundos = static_cast<double>(Metricas::ahoraNs() - inicioNs) / 1e9;
+
+        delete[] seleccion;
+        delete[] grupos;
+        delete[] lecturas;
+        delete[] parciales;
+        delete[] tramos;
+    }
+};
+
+#endif // CONSULTASFLOTA_H
@@ -0,0 +1,697 @@
+/**
+ * @file ExportadorLecturas.h
+ * @brief Exportación asíncrona de lecturas a archivos CSV o binarios columnares
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * La ingesta copia cada lectura a un buffer en memoria; cuando se llena
+ * (o pasa el intervalo de entrega) lo intercambia con el segundo buffer
+ * y un hilo escritor lo vuelca a disco. La ingesta nunca espera a la E/S.
+ *
+ * Formato CSV (un encabezado por archivo):
+ * @verbatim
+ * marca_ns,sensor,tipo,valor
+ * 1760790000123456789,T-001,T,23.4
+ * 1760790000123457001,"A,B",T,21.9
+ * @endverbatim
+ * Los IDs con coma, comillas o saltos de línea van entre comillas y con
+ * las comillas internas duplicadas (RFC 4180).
+ *
+ * Formato binario columnar (little-endian). Cabecera de archivo
+ * "IOTC" + versión u16 + reservado u16, seguida de bloques:
+ * @verbatim
+ * u32 numNombres   { u32 id, u8 tipo, u8 largo, char nombre[largo] } x numNombres
+ * u32 numFilas     u64 marca_ns[numFilas]  u32 id[numFilas]
+ *                  u8 tipo[numFilas]       f64 valor[numFilas]
+ * @endverbatim
+ * Cada archivo es autocontenido: su primer bloque trae todos los nombres
+ * conocidos y los siguientes sólo los IDs nuevos.
+ */
+
+#ifndef EXPORTADORLECTURAS_H
+#define EXPORTADORLECTURAS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include "Metricas.h"
+#include "TablaSimbolos.h"
+
+/**
+ * @enum FormatoExportacion
+ * @brief Formato de los archivos exportados
+ */
+enum class FormatoExportacion {
+    CSV,      ///< Texto, una lectura por línea
+    Binario   ///< Bloques columnares (ver encabezado del archivo)
+};
+
+/**
+ * @struct ConfigExportacion
+ * @brief Parámetros del exportador
+ */
+struct ConfigExportacion {
+    std::string prefijo;          ///< Archivos PREFIJO-000001.csv / .iotc
+    FormatoExportacion formato;   ///< CSV o binario
+    int lecturasPorBuffer;        ///< Capacidad de cada uno de los dos buffers
+    uint64_t bytesPorArchivo;     ///< Rotación al superar este tamaño (0 = sin rotación)
+    int msEntrega;                ///< Máximo que una lectura espera en el buffer de ingesta
+                                  ///< (con el enlace en silencio, vía entregarVencido())
+    bool esperarEscritor;         ///< true: la ingesta espera si el escritor va atrasado;
+                                  ///< false: descarta el buffer (ingesta en vivo)
+
+    ConfigExportacion()
+        : prefijo("lecturas"), formato(FormatoExportacion::CSV), lecturasPorBuffer(65536),
+          bytesPorArchivo(64ULL * 1024 * 1024), msEntrega(1000), esperarEscritor(false) {}
+};
+
+/**
+ * @class BufferExportacion
+ * @brief Lecturas pendientes de exportar, guardadas por columnas
+ *
+ * @details
+ * Además de las filas lleva los nombres de los IDs que se exportan por
+ * primera vez, copiados en el hilo de ingesta: el escritor nunca consulta
+ * TablaSimbolos, que no es segura entre hilos.
+ */
+class BufferExportacion {
+public:
+    static const int LARGO_NOMBRE = TablaSimbolos::LARGO_MAXIMO + 1;
+
+    uint64_t* marcas;
+    uint32_t* ids;
+    char* tipos;
+    double* valores;
+    int cantidad;
+    int capacidad;
+
+    uint32_t* nuevosIds;
+    char* nuevosTipos;
+    uint8_t* nuevosDigitos;
+    char (*nuevosNombres)[LARGO_NOMBRE];
+    int numNuevos;
+    int capacidadNuevos;
+
+    BufferExportacion()
+        : marcas(nullptr), ids(nullptr), tipos(nullptr), valores(nullptr), cantidad(0),
+          capacidad(0), nuevosIds(nullptr), nuevosTipos(nullptr), nuevosDigitos(nullptr),
+          nuevosNombres(nullptr), numNuevos(0), capacidadNuevos(0) {}
+
+    ~BufferExportacion() {
+        liberar();
+    }
+
+    BufferExportacion(const BufferExportacion&) = delete;
+    BufferExportacion& operator=(const BufferExportacion&) = delete;
+
+    void reservar(int lecturas) {
+        liberar();
+        marcas = new uint64_t[lecturas];
+        ids = new uint32_t[lecturas];
+        tipos = new char[lecturas];
+        valores = new double[lecturas];
+        capacidad = lecturas;
+    }
+
+    void agregar(uint64_t marca, uint32_t id, char tipo, double valor) {
+        marcas[cantidad] = marca;
+        ids[cantidad] = id;
+        tipos[cantidad] = tipo;
+        valores[cantidad] = valor;
+        cantidad++;
+    }
+
+    void agregarNombre(uint32_t id, char tipo, uint8_t digitos, const char* nombre) {
+        if (numNuevos == capacidadNuevos) {
+            crecerNuevos();
+        }
+        nuevosIds[numNuevos] = id;
+        nuevosTipos[numNuevos] = tipo;
+        nuevosDigitos[numNuevos] = digitos;
+        std::strncpy(nuevosNombres[numNuevos], nombre, LARGO_NOMBRE - 1);
+        nuevosNombres[numNuevos][LARGO_NOMBRE - 1] = '\0';
+        numNuevos++;
+    }
+
+    bool lleno() const { return cantidad == capacidad; }
+    bool vacio() const { return cantidad == 0 && numNuevos == 0; }
+
+    void vaciar() {
+        cantidad = 0;
+        numNuevos = 0;
+    }
+
+private:
+    void crecerNuevos() {
+        int nueva = capacidadNuevos == 0 ? 64 : capacidadNuevos * 2;
+        uint32_t* ids2 = new uint32_t[nueva];
+        char* tipos2 = new char[nueva];
+        uint8_t* digitos2 = new uint8_t[nueva];
+        char (*nombres2)[LARGO_NOMBRE] = new char[nueva][LARGO_NOMBRE];
+        if (numNuevos > 0) {
+            std::memcpy(ids2, nuevosIds, sizeof(uint32_t) * numNuevos);
+            std::memcpy(tipos2, nuevosTipos, numNuevos);
+            std::memcpy(digitos2, nuevosDigitos, numNuevos);
+            std::memcpy(nombres2, nuevosNombres, sizeof(nuevosNombres[0]) * numNuevos);
+        }
+        delete[] nuevosIds;
+        delete[] nuevosTipos;
+        delete[] nuevosDigitos;
+        delete[] nuevosNombres;
+        nuevosIds = ids2;
+        nuevosTipos = tipos2;
+        nuevosDigitos = digitos2;
+        nuevosNombres = nombres2;
+        capacidadNuevos = nueva;
+    }
+
+    void liberar() {
+        delete[] marcas;
+        delete[] ids;
+        delete[] tipos;
+        delete[] valores;
+        delete[] nuevosIds;
+        delete[] nuevosTipos;
+        delete[] nuevosDigitos;
+        delete[] nuevosNombres;
+        marcas = nullptr;
+        ids = nullptr;
+        tipos = nullptr;
+        valores = nullptr;
+        nuevosIds = nullptr;
+        nuevosTipos = nullptr;
+        nuevosDigitos = nullptr;
+        nuevosNombres = nullptr;
+        cantidad = capacidad = numNuevos = capacidadNuevos = 0;
+    }
+};
+
+/**
+ * @class ExportadorLecturas
+ * @brief Doble buffer entre la ingesta y un hilo escritor con rotación de archivos
+ *
+ * @details
+ * - registrar() corre en el hilo de ingesta: copia la lectura al buffer
+ *   activo (cuatro escrituras en arreglos) y no toma ningún candado salvo
+ *   al entregar un buffer completo.
+ * - entregar() pasa el buffer activo al escritor y continúa con el otro.
+ *   Si el escritor todavía no terminó el anterior, según la configuración
+ *   se espera (modo por lotes) o se descartan las filas y se cuentan en
+ *   Contador::ExportacionDescartadas (ingesta en vivo). Los nombres nuevos
+ *   del buffer descartado se conservan.
+ * - El escritor rota de archivo al superar bytesPorArchivo.
+ * - registrar() sólo revisa msEntrega cuando llega una lectura; el lector
+ *   del puerto llama además a entregarVencido() desde su tarea periódica
+ *   para que las últimas lecturas no esperen a la siguiente.
+ *
+ * @note registrar(), iniciar() y detener() deben llamarse desde el hilo
+ *       de ingesta (igual que MotorReglas).
+ *
+ * Ejemplo de uso:
+ * @code
+ * ConfigExportacion config;
+ * config.prefijo = "datos/lecturas";
+ * config.formato = FormatoExportacion::Binario;
+ * ExportadorLecturas::global().iniciar(config);
+ * ...                                   // la ingesta llama a registrar()
+ * ExportadorLecturas::global().detener();
+ * @endcode
+ */
+class ExportadorLecturas {
+private:
+    ConfigExportacion config;
+    bool activo;
+
+    // Lado de ingesta
+    BufferExportacion buffers[2];
+    BufferExportacion* actual;
+    uint64_t entregaNs;
+    uint64_t ultimaEntregaNs;
+    int64_t desfaseNs;                 // steady_clock -> época Unix
+    bool* anotados;                    // ID ya enviado al escritor
+    uint32_t capacidadAnotados;
+
+    // Intercambio
+    std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    std::condition_variable hayLibre;
+    BufferExportacion* pendiente;
+    bool terminar;
+    std::thread escritor;
+
+    // Lado del escritor
+    std::ofstream archivo;
+    int numArchivo;
+    uint64_t bytesArchivo;
+    bool archivoConNombres;
+    char (*nombres)[BufferExportacion::LARGO_NOMBRE];
+    char* tiposNombre;
+    uint8_t* digitos;
+    bool* comillas;                    // El nombre debe citarse en CSV
+    uint32_t capacidadNombres;
+    uint32_t numNombres;               // 1 + mayor ID conocido
+    char* texto;                       // salida CSV formateada de un buffer
+
+    // Estadísticas (escritas por el escritor, leídas por cualquiera)
+    std::atomic<uint64_t> escritas;
+    std::atomic<uint64_t> descartadas;
+    std::atomic<uint64_t> bytesEscritos;
+    std::atomic<int> archivos;
+
+    // Nombre citado: comillas de apertura y cierre y cada carácter duplicado
+    static const size_t LARGO_CAMPO_CSV = 2 * TablaSimbolos::LARGO_MAXIMO + 3;
+    // marca (20) + nombre citado (100) + tipo + valor %.15g (23) + separadores, con holgura
+    static const size_t LARGO_FILA_CSV = 160;
+
+public:
+    ExportadorLecturas()
+        : activo(false), actual(nullptr), entregaNs(0), ultimaEntregaNs(0), desfaseNs(0),
+          anotados(nullptr), capacidadAnotados(0), pendiente(nullptr), terminar(false),
+          numArchivo(0), bytesArchivo(0), archivoConNombres(false), nombres(nullptr),
+          tiposNombre(nullptr), digitos(nullptr), comillas(nullptr), capacidadNombres(0), numNombres(0),
+          texto(nullptr), escritas(0), descartadas(0), bytesEscritos(0), archivos(0) {}
+
+    ~ExportadorLecturas() {
+        detener();
+        delete[] anotados;
+        delete[] nombres;
+        delete[] tiposNombre;
+        delete[] digitos;
+        delete[] comillas;
+        delete[] texto;
+    }
+
+    ExportadorLecturas(const ExportadorLecturas&) = delete;
+    ExportadorLecturas& operator=(const ExportadorLecturas&) = delete;
+
+    /**
+     * @brief Exportador compartido por la ruta de ingesta
+     */
+    static ExportadorLecturas& global() {
+        static ExportadorLecturas exportador;
+        return exportador;
+    }
+
+    /**
+     * @brief Reserva los buffers y lanza el hilo escritor
+     * @return false si ya estaba activo o la configuración no es válida
+     * @details La numeración de archivos continúa entre sesiones del
+     *          mismo proceso; las estadísticas se reinician.
+     */
+    bool iniciar(const ConfigExportacion& nueva) {
+        if (activo) {
+            std::cerr << "Error: la exportación ya está activa" << std::endl;
+            return false;
+        }
+        if (nueva.lecturasPorBuffer <= 0 || nueva.prefijo.empty()) {
+            std::cerr << "Error: configuración de exportación inválida" << std::endl;
+            return false;
+        }
+        config = nueva;
+        buffers[0].reservar(config.lecturasPorBuffer);
+        buffers[1].reservar(config.lecturasPorBuffer);
+        actual = &buffers[0];
+        pendiente = nullptr;
+        terminar = false;
+        for (uint32_t i = 0; i < capacidadAnotados; i++) {
+            anotados[i] = false;
+        }
+        numNombres = 0;
+        archivoConNombres = false;
+        delete[] texto;
+        texto = config.formato == FormatoExportacion::CSV
+                    ? new char[static_cast<size_t>(config.lecturasPorBuffer) * LARGO_FILA_CSV]
+                    : nullptr;
+        escritas = 0;
+        descartadas = 0;
+        bytesEscritos = 0;
+        archivos = 0;
+
+        int64_t epoca = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        uint64_t ahora = Metricas::ahoraNs();
+        desfaseNs = epoca - static_cast<int64_t>(ahora);
+        entregaNs = static_cast<uint64_t>(config.msEntrega) * 1000000ULL;
+        ultimaEntregaNs = ahora;
+
+        escritor = std::thread(&ExportadorLecturas::escribir, this);
+        activo = true;
+        return true;
+    }
+
+    /**
+     * @brief Entrega lo pendiente, espera al escritor y cierra el archivo
+     */
+    void detener() {
+        if (!activo) {
+            return;
+        }
+        activo = false;
+        {
+            std::unique_lock<std::mutex> candado(mutex);
+            hayLibre.wait(candado, [this] { return pendiente == nullptr; });
+            if (!actual->vacio()) {
+                pendiente = actual;
+            }
+            terminar = true;
+        }
+        hayTrabajo.notify_one();
+        escritor.join();
+    }
+
+    bool estaActivo() const {
+        return activo;
+    }
+
+    /**
+     * @brief Copia una lectura al buffer de ingesta
+     * @tparam Valor Tipo de la lectura; define los dígitos del CSV
+     * @param sensor ID internado
+     * @param tipo Letra del protocolo ('T', 'P', 'V', ...)
+     */
+    template <typename Valor>
+    void registrar(uint32_t sensor, char tipo, Valor valor) {
+        uint64_t ahora = Metricas::ahoraNs();
+        if (sensor >= capacidadAnotados || !anotados[sensor]) {
+            anotar(sensor, tipo, digitosDe<Valor>());
+        }
+        actual->agregar(static_cast<uint64_t>(static_cast<int64_t>(ahora) + desfaseNs),
+                        sensor, tipo, static_cast<double>(valor));
+        if (actual->lleno() || ahora - ultimaEntregaNs >= entregaNs) {
+            entregar(ahora);
+        }
+    }
+
+    /**
+     * @brief Entrega el buffer activo si esperar @p periodoNs más superaría msEntrega
+     * @param ahora Metricas::ahoraNs() actual
+     * @param periodoNs Tiempo hasta la próxima llamada (período de la tarea)
+     * @details Corre en el hilo de ingesta, desde SerialPort::setTareaPeriodica.
+     */
+    void entregarVencido(uint64_t ahora, uint64_t periodoNs) {
+        if (activo && !actual->vacio() && ahora + periodoNs - ultimaEntregaNs > entregaNs) {
+            entregar(ahora);
+        }
+    }
+
+    const ConfigExportacion& getConfig() const { return config; }
+    uint64_t getEscritas() const { return escritas.load(std::memory_order_relaxed); }
+    uint64_t getDescartadas() const { return descartadas.load(std::memory_order_relaxed); }
+    uint64_t getBytes() const { return bytesEscritos.load(std::memory_order_relaxed); }
+    int getArchivos() const { return archivos.load(std::memory_order_relaxed); }
+    int getUltimoArchivo() const { return numArchivo; }
+
+    /**
+     * @brief Nombre del archivo número @p numero con el prefijo y formato actuales
+     */
+    std::string nombreArchivo(int numero) const {
+        char sufijo[32];
+        std::snprintf(sufijo, sizeof(sufijo), "-%06d.%s", numero,
+                      config.formato == FormatoExportacion::CSV ? "csv" : "iotc");
+        return config.prefijo + sufijo;
+    }
+
+    void imprimirResumen() const {
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << "Exportación (" << (config.formato == FormatoExportacion::CSV ? "CSV" : "binaria")
+                  << "): " << getEscritas() << " lecturas en " << getArchivos() << " archivo(s), "
+                  << std::fixed << std::setprecision(1) << getBytes() / (1024.0 * 1024.0)
+                  << " MiB, " << getDescartadas() << " descartadas" << std::endl;
+        std::cout.flags(formato);
+        std::cout.precision(precision);
+    }
+
+private:
+    template <typename Valor>
+    static uint8_t digitosDe() {
+        return static_cast<uint8_t>(std::numeric_limits<Valor>::digits10 +
+                                    (std::is_integral<Valor>::value ? 1 : 0));
+    }
+
+    // Primera lectura exportada de un ID: copiar su nombre para el escritor
+    void anotar(uint32_t sensor, char tipo, uint8_t digitosValor) {
+        if (sensor >= capacidadAnotados) {
+            uint32_t nueva = capacidadAnotados == 0 ? 64 : capacidadAnotados;
+            while (nueva <= sensor) {
+                nueva *= 2;
+            }
+            bool* mayor = new bool[nueva];
+            for (uint32_t i = 0; i < nueva; i++) {
+                mayor[i] = i < capacidadAnotados ? anotados[i] : false;
+            }
+            delete[] anotados;
+            anotados = mayor;
+            capacidadAnotados = nueva;
+        }
+        anotados[sensor] = true;
+        actual->agregarNombre(sensor, tipo, digitosValor, TablaSimbolos::global().nombre(sensor));
+    }
+
+    void entregar(uint64_t ahora) {
+        ultimaEntregaNs = ahora;
+        if (actual->vacio()) {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> candado(mutex);
+            if (pendiente != nullptr && config.esperarEscritor) {
+                hayLibre.wait(candado, [this] { return pendiente == nullptr; });
+            }
+            if (pendiente != nullptr) {
+                // El escritor va atrasado: se pierden las filas, no los nombres
+                descartadas.fetch_add(static_cast<uint64_t>(actual->cantidad),
+                                      std::memory_order_relaxed);
+                Metricas::incrementar(Contador::ExportacionDescartadas,
+                                      static_cast<uint64_t>(actual->cantidad));
+                actual->cantidad = 0;
+                return;
+            }
+            pendiente = actual;
+            actual = (actual == &buffers[0]) ? &buffers[1] : &buffers[0];
+        }
+        hayTrabajo.notify_one();
+    }
+
+    // Hilo escritor
+    void escribir() {
+        std::unique_lock<std::mutex> candado(mutex);
+        while (true) {
+            hayTrabajo.wait(candado, [this] { return pendiente != nullptr || terminar; });
+            if (pendiente == nullptr) {
+                break;
+            }
+            BufferExportacion* buffer = pendiente;
+            candado.unlock();
+            volcar(*buffer);
+            buffer->vaciar();
+            candado.lock();
+            pendiente = nullptr;
+            hayLibre.notify_one();
+        }
+        candado.unlock();
+        if (archivo.is_open()) {
+            archivo.close();
+        }
+    }
+
+    void volcar(const BufferExportacion& buffer) {
+        for (int i = 0; i < buffer.numNuevos; i++) {
+            recordarNombre(buffer.nuevosIds[i], buffer.nuevosTipos[i], buffer.nuevosDigitos[i],
+                           buffer.nuevosNombres[i]);
+        }
+        if (buffer.cantidad == 0 && config.formato == FormatoExportacion::CSV) {
+            return;
+        }
+        if (!archivo.is_open() && !abrirSiguiente()) {
+            descartadas.fetch_add(static_cast<uint64_t>(buffer.cantidad), std::memory_order_relaxed);
+            Metricas::incrementar(Contador::ExportacionDescartadas,
+                                  static_cast<uint64_t>(buffer.cantidad));
+            return;
+        }
+
+        uint64_t antes = bytesArchivo;
+        if (config.formato == FormatoExportacion::CSV) {
+            volcarCSV(buffer);
+        } else {
+            volcarBinario(buffer);
+        }
+        archivo.flush();   // msEntrega se cumple en disco, no en el búfer de ofstream
+        if (!archivo) {
+            std::cerr << "Error: falló la escritura de " << nombreArchivo(numArchivo) << std::endl;
+            archivo.close();
+            return;
+        }
+        escritas.fetch_add(static_cast<uint64_t>(buffer.cantidad), std::memory_order_relaxed);
+        bytesEscritos.fetch_add(bytesArchivo - antes, std::memory_order_relaxed);
+        Metricas::incrementar(Contador::LecturasExportadas, static_cast<uint64_t>(buffer.cantidad));
+        Metricas::incrementar(Contador::BytesExportados, bytesArchivo - antes);
+
+        if (config.bytesPorArchivo > 0 && bytesArchivo >= config.bytesPorArchivo) {
+            archivo.close();
+        }
+    }
+
+    bool abrirSiguiente() {
+        numArchivo++;
+        std::string ruta = nombreArchivo(numArchivo);
+        archivo.open(ruta.c_str(), std::ios::binary | std::ios::trunc);
+        if (!archivo) {
+            std::cerr << "Error: No se pudo crear " << ruta << std::endl;
+            return false;
+        }
+        archivos.fetch_add(1, std::memory_order_relaxed);
+        bytesArchivo = 0;
+        archivoConNombres = false;
+        if (config.formato == FormatoExportacion::CSV) {
+            static const char encabezado[] = "marca_ns,sensor,tipo,valor\n";
+            escribirBytes(encabezado, sizeof(encabezado) - 1);
+        } else {
+            static const char cabecera[8] = {'I', 'O', 'T', 'C', 1, 0, 0, 0};
+            escribirBytes(cabecera, sizeof(cabecera));
+        }
+        return true;
+    }
+
+    void volcarCSV(const BufferExportacion& buffer) {
+        char* p = texto;
+        char campo[LARGO_CAMPO_CSV];
+        for (int i = 0; i < buffer.cantidad; i++) {
+            uint32_t id = buffer.ids[i];
+            const char* nombre = id < numNombres ? nombres[id] : "";
+            if (id < numNombres && comillas[id]) {
+                citarCSV(nombre, campo);
+                nombre = campo;
+            }
+            int precision = id < numNombres ? digitos[id] : 15;
+            int largo = std::snprintf(p, LARGO_FILA_CSV, "%llu,%s,%c,%.*g\n",
+                                      static_cast<unsigned long long>(buffer.marcas[i]), nombre,
+                                      buffer.tipos[i], precision, buffer.valores[i]);
+            if (largo > 0) {
+                p += largo < static_cast<int>(LARGO_FILA_CSV) ? largo : LARGO_FILA_CSV - 1;
+            }
+        }
+        escribirBytes(texto, static_cast<size_t>(p - texto));
+    }
+
+    // "A,B" -> "\"A,B\"", con las comillas internas duplicadas
+    static void citarCSV(const char* nombre, char* destino) {
+        *destino++ = '"';
+        for (; *nombre != '\0'; nombre++) {
+            if (*nombre == '"') {
+                *destino++ = '"';
+            }
+            *destino++ = *nombre;
+        }
+        *destino++ = '"';
+        *destino = '\0';
+    }
+
+    void volcarBinario(const BufferExportacion& buffer) {
+        // Nombres: todos al empezar un archivo, luego sólo los nuevos
+        if (!archivoConNombres) {
+            uint32_t total = 0;
+            for (uint32_t id = 0; id < numNombres; id++) {
+                total += nombres[id][0] != '\0' ? 1 : 0;
+            }
+            escribirValor(total);
+            for (uint32_t id = 0; id < numNombres; id++) {
+                if (nombres[id][0] != '\0') {
+                    escribirNombre(id);
+                }
+            }
+            archivoConNombres = true;
+        } else {
+            escribirValor(static_cast<uint32_t>(buffer.numNuevos));
+            for (int i = 0; i < buffer.numNuevos; i++) {
+                escribirNombre(buffer.nuevosIds[i]);
+            }
+        }
+
+        size_t n = static_cast<size_t>(buffer.cantidad);
+        escribirValor(static_cast<uint32_t>(n));
+        escribirBytes(buffer.marcas, sizeof(uint64_t) * n);
+        escribirBytes(buffer.ids, sizeof(uint32_t) * n);
+        escribirBytes(buffer.tipos, n);
+        escribirBytes(buffer.valores, sizeof(double) * n);
+    }
+
+    void escribirNombre(uint32_t id) {
+        uint8_t largo = static_cast<uint8_t>(std::strlen(nombres[id]));
+        escribirValor(id);
+        escribirBytes(&tiposNombre[id], 1);
+        escribirBytes(&largo, 1);
+        escribirBytes(nombres[id], largo);
+    }
+
+    template <typename T>
+    void escribirValor(T valor) {
+        escribirBytes(&valor, sizeof(T));
+    }
+
+    void escribirBytes(const void* datos, size_t n) {
+        archivo.write(static_cast<const char*>(datos), static_cast<std::streamsize>(n));
+        bytesArchivo += n;
+    }
+
+    // Diccionario propio del escritor (ID -> nombre, tipo y dígitos)
+    void recordarNombre(uint32_t id, char tipo, uint8_t digitosValor, const char* nombre) {
+        if (id >= capacidadNombres) {
+            uint32_t nueva = capacidadNombres == 0 ? 64 : capacidadNombres;
+            while (nueva <= id) {
+                nueva *= 2;
+            }
+            char (*mayor)[BufferExportacion::LARGO_NOMBRE] = new char[nueva][BufferExportacion::LARGO_NOMBRE];
+            char* tiposMayor = new char[nueva];
+            uint8_t* digitosMayor = new uint8_t[nueva];
+            bool* comillasMayor = new bool[nueva];
+            for (uint32_t i = 0; i < nueva; i++) {
+                if (i < capacidadNombres) {
+                    std::memcpy(mayor[i], nombres[i], BufferExportacion::LARGO_NOMBRE);
+                    tiposMayor[i] = tiposNombre[i];
+                    digitosMayor[i] = digitos[i];
+                    comillasMayor[i] = comillas[i];
+                } else {
+                    mayor[i][0] = '\0';
+                    tiposMayor[i] = 0;
+                    digitosMayor[i] = 15;
+                    comillasMayor[i] = false;
+                }
+            }
+            delete[] nombres;
+            delete[] tiposNombre;
+            delete[] digitos;
+            delete[] comillas;
+            nombres = mayor;
+            tiposNombre = tiposMayor;
+            digitos = digitosMayor;
+            comillas = comillasMayor;
+            capacidadNombres = nueva;
+        }
+        std::memcpy(nombres[id], nombre, BufferExportacion::LARGO_NOMBRE);
+        tiposNombre[id] = tipo;
+        digitos[id] = digitosValor;
+        comillas[id] = std::strpbrk(nombres[id], ",\"\r\n") != nullptr;
+        if (id >= numNombres) {
+            for (uint32_t i = numNombres; i < id; i++) {
+                nombres[i][0] = '\0';
+                comillas[i] = false;
+            }
+            numNombres = id + 1;
+        }
+    }
+};
+
+#endif // EXPORTADORLECTURAS_H
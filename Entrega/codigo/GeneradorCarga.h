@@ -0,0 +1,353 @@
+/**
+ * @file GeneradorCarga.h
+ * @brief Generador sintético de tráfico Arduino sobre un pseudo-terminal
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Crea un pseudo-terminal y escribe en su extremo maestro líneas con el
+ * mismo formato que envía el Arduino ("T ID VALOR" / "P ID VALOR") o
+ * tramas de ProtocoloBinario. El extremo esclavo se abre con SerialPort
+ * como si fuera /dev/ttyACM0.
+ */
+
+#ifndef GENERADORCARGA_H
+#define GENERADORCARGA_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "ProtocoloBinario.h"
+
+/**
+ * @enum DistribucionSensores
+ * @brief Cómo se reparte el tráfico entre los sensores simulados
+ */
+enum class DistribucionSensores {
+    Uniforme,   ///< Todos los sensores reciben la misma proporción de lecturas
+    Zipf        ///< Pocos sensores "calientes" reciben la mayoría (s = 1)
+};
+
+/**
+ * @struct ConfigGenerador
+ * @brief Parámetros del generador de carga
+ */
+struct ConfigGenerador {
+    int numSensores;                     ///< Sensores distintos a simular (binario: hasta 65536)
+    double lecturasPorSegundo;           ///< Tasa objetivo (0 = sin límite)
+    DistribucionSensores distribucion;   ///< Reparto de lecturas por sensor
+    double proporcionMalformadas;        ///< Fracción [0, 1] de líneas inválidas
+    double proporcionTemperatura;        ///< Fracción [0, 1] de sensores tipo T
+    double proporcionPicos;              ///< Fracción [0, 1] de lecturas fuera de rango (60 °C / 120000 Pa)
+    unsigned int semilla;                ///< Semilla del generador aleatorio
+    bool binario;                        ///< Emitir tramas binarias en lugar de texto
+
+    ConfigGenerador()
+        : numSensores(16), lecturasPorSegundo(1000.0),
+          distribucion(DistribucionSensores::Uniforme),
+          proporcionMalformadas(0.0), proporcionTemperatura(0.5), proporcionPicos(0.0), semilla(42),
+          binario(false) {}
+};
+
+/**
+ * @class GeneradorCarga
+ * @brief Emite líneas de sensores simulados en un pseudo-terminal
+ *
+ * @details
+ * El hilo emisor acumula las líneas de cada milisegundo en un búfer y
+ * las escribe con una sola llamada a write(). Si el lector no consume a
+ * tiempo, el emisor espera a que haya espacio en el pseudo-terminal y
+ * queda limitado por el lector, que es justamente lo que mide la tasa
+ * sostenida.
+ *
+ * Ejemplo de uso:
+ * @code
+ * GeneradorCarga gen(config);
+ * SerialPort puerto;
+ * gen.crear();
+ * puerto.abrir(gen.getRutaEsclavo(), 115200, false);
+ * gen.iniciar();
+ * // ... leer con puerto.leerLinea() ...
+ * gen.detener();
+ * @endcode
+ */
+class GeneradorCarga {
+private:
+    static const int PICO_TEMPERATURA = 60;    // °C, fuera de los umbrales por defecto
+    static const int PICO_PRESION = 120000;    // Pa
+
+    ConfigGenerador config;
+    int fdMaestro;
+    std::string rutaEsclavo;
+    std::thread hilo;
+    std::atomic<bool> activo;
+    std::atomic<unsigned long long> lineasEmitidas;
+    double* acumuladaZipf;   // Distribución acumulada para el modo Zipf
+
+public:
+    GeneradorCarga(const ConfigGenerador& cfg = ConfigGenerador())
+        : config(cfg), fdMaestro(-1), activo(false), lineasEmitidas(0),
+          acumuladaZipf(nullptr) {
+        if (config.numSensores < 1) {
+            config.numSensores = 1;
+        }
+        if (config.binario && config.numSensores > ProtocoloBinario::MAX_SENSORES) {
+            // Más sensores se repetirían índice y se fundirían en uno
+            std::cerr << "Advertencia: el protocolo binario admite hasta "
+                      << ProtocoloBinario::MAX_SENSORES << " sensores" << std::endl;
+            config.numSensores = ProtocoloBinario::MAX_SENSORES;
+        }
+    }
+
+    ~GeneradorCarga() {
+        detener();
+        delete[] acumuladaZipf;
+    }
+
+    // No copiable: posee un descriptor y un hilo
+    GeneradorCarga(const GeneradorCarga&) = delete;
+    GeneradorCarga& operator=(const GeneradorCarga&) = delete;
+
+    /**
+     * @brief Crea el pseudo-terminal
+     * @return true si el extremo esclavo está listo para abrirse
+     */
+    bool crear() {
+        fdMaestro = posix_openpt(O_RDWR | O_NOCTTY);
+        if (fdMaestro < 0 || grantpt(fdMaestro) != 0 || unlockpt(fdMaestro) != 0) {
+            std::cerr << "Error: No se pudo crear el pseudo-terminal" << std::endl;
+            cerrarMaestro();
+            return false;
+        }
+        const char* nombre = ptsname(fdMaestro);
+        if (nombre == nullptr) {
+            std::cerr << "Error: ptsname falló" << std::endl;
+            cerrarMaestro();
+            return false;
+        }
+        rutaEsclavo = nombre;
+        fcntl(fdMaestro, F_SETFL, fcntl(fdMaestro, F_GETFL) | O_NONBLOCK);
+        return true;
+    }
+
+    /**
+     * @brief Arranca el hilo emisor
+     * @details Debe llamarse después de abrir (y configurar en modo raw)
+     *          el extremo esclavo, para que ninguna línea se pierda.
+     */
+    void iniciar() {
+        if (fdMaestro < 0 || activo.load()) {
+            return;
+        }
+        activo.store(true);
+        hilo = std::thread(&GeneradorCarga::emitir, this);
+    }
+
+    /**
+     * @brief Detiene el hilo y cierra el maestro
+     * @details Al cerrarse el maestro, el lector recibe EIO y
+     *          SerialPort::leerLinea() retorna false.
+     */
+    void detener() {
+        activo.store(false);
+        if (hilo.joinable()) {
+            hilo.join();
+        }
+        cerrarMaestro();
+    }
+
+    const std::string& getRutaEsclavo() const {
+        return rutaEsclavo;
+    }
+
+    unsigned long long getLineasEmitidas() const {
+        return lineasEmitidas.load();
+    }
+
+private:
+    void cerrarMaestro() {
+        if (fdMaestro >= 0) {
+            close(fdMaestro);
+            fdMaestro = -1;
+        }
+    }
+
+    // Construye la tabla acumulada P(k) ∝ 1/k para el modo Zipf
+    void prepararZipf() {
+        delete[] acumuladaZipf;
+        acumuladaZipf = new double[config.numSensores];
+        double total = 0.0;
+        for (int k = 0; k < config.numSensores; k++) {
+            total += 1.0 / (k + 1);
+            acumuladaZipf[k] = total;
+        }
+        for (int k = 0; k < config.numSensores; k++) {
+            acumuladaZipf[k] /= total;
+        }
+    }
+
+    int elegirSensor(std::mt19937& rng, std::uniform_real_distribution<double>& u01) {
+        if (config.distribucion == DistribucionSensores::Uniforme) {
+            return static_cast<int>(rng() % static_cast<unsigned int>(config.numSensores));
+        }
+        // Búsqueda binaria sobre la acumulada
+        double r = u01(rng);
+        int bajo = 0;
+        int alto = config.numSensores - 1;
+        while (bajo < alto) {
+            int medio = (bajo + alto) / 2;
+            if (acumuladaZipf[medio] < r) {
+                bajo = medio + 1;
+            } else {
+                alto = medio;
+            }
+        }
+        return bajo;
+    }
+
+    // Escribe una línea (válida o malformada) al final del búfer
+    int formatearLinea(char* buf, int capacidad, std::mt19937& rng,
+                       std::uniform_real_distribution<double>& u01,
+                       std::normal_distribution<double>& ruido) {
+        int sensor = elegirSensor(rng, u01);
+        int numTemperatura = static_cast<int>(config.numSensores * config.proporcionTemperatura + 0.5);
+        bool esTemperatura = sensor < numTemperatura;
+        char tipo = esTemperatura ? 'T' : 'P';
+
+        if (config.binario) {
+            return formatearTrama(reinterpret_cast<unsigned char*>(buf), sensor, tipo, rng, u01, ruido);
+        }
+
+        if (u01(rng) < config.proporcionMalformadas) {
+            switch (rng() % 5) {
+                case 0:  return std::snprintf(buf, capacidad, "%c %c-%03d abc\n", tipo, tipo, sensor);
+                case 1:  return std::snprintf(buf, capacidad, "X X-%03d 7\n", sensor);
+                case 2:  return std::snprintf(buf, capacidad, "%.1f\n", 20.0 + ruido(rng));
+                case 3:  return std::snprintf(buf, capacidad, "%c %c-%03d\n", tipo, tipo, sensor);
+                default: return std::snprintf(buf, capacidad, "#\n");
+            }
+        }
+
+        if (esTemperatura) {
+            return std::snprintf(buf, capacidad, "T T-%03d %.1f\n", sensor,
+                                 pico(rng, u01) ? PICO_TEMPERATURA : 22.0 + 3.0 * ruido(rng));
+        }
+        return std::snprintf(buf, capacidad, "P P-%03d %d\n", sensor,
+                             pico(rng, u01) ? PICO_PRESION
+                                            : static_cast<int>(std::lround(101325.0 + 500.0 * ruido(rng))));
+    }
+
+    // Sólo consume el generador si hay picos, para no alterar la secuencia por defecto
+    bool pico(std::mt19937& rng, std::uniform_real_distribution<double>& u01) {
+        return config.proporcionPicos > 0.0 && u01(rng) < config.proporcionPicos;
+    }
+
+    // Trama binaria; las malformadas llevan un bit invertido (falla el CRC)
+    // o un byte basura antes de la trama (prueba la resincronización)
+    int formatearTrama(unsigned char* buf, int sensor, char tipo, std::mt19937& rng,
+                       std::uniform_real_distribution<double>& u01,
+                       std::normal_distribution<double>& ruido) {
+        TramaBinaria trama;
+        trama.indice = static_cast<uint16_t>(sensor);
+        trama.tipo = tipo;
+        if (pico(rng, u01)) {
+            trama.valor = (tipo == 'T') ? static_cast<int32_t>(PICO_TEMPERATURA * 100) : PICO_PRESION;
+        } else {
+            trama.valor = (tipo == 'T')
+                ? static_cast<int32_t>(std::lround((22.0 + 3.0 * ruido(rng)) * 100.0))
+                : static_cast<int32_t>(std::lround(101325.0 + 500.0 * ruido(rng)));
+        }
+
+        int offset = 0;
+        bool malformada = u01(rng) < config.proporcionMalformadas;
+        if (malformada && rng() % 2 == 0) {
+            buf[offset++] = static_cast<unsigned char>(rng() % 256);
+            malformada = false;
+        }
+        ProtocoloBinario::codificar(trama, buf + offset);
+        if (malformada) {
+            int byte = 1 + static_cast<int>(rng() % (ProtocoloBinario::LONGITUD_TRAMA - 1));
+            buf[offset + byte] ^= static_cast<unsigned char>(1u << (rng() % 8));
+        }
+        return offset + ProtocoloBinario::LONGITUD_TRAMA;
+    }
+
+    void emitir() {
+        const int CAPACIDAD = 64 * 1024;
+        char* buffer = new char[CAPACIDAD];
+        std::mt19937 rng(config.semilla);
+        std::uniform_real_distribution<double> u01(0.0, 1.0);
+        std::normal_distribution<double> ruido(0.0, 1.0);
+        if (config.distribucion == DistribucionSensores::Zipf) {
+            prepararZipf();
+        }
+
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        unsigned long long emitidas = 0;
+
+        while (activo.load(std::memory_order_relaxed)) {
+            // Cuántas líneas deberían haberse emitido hasta ahora
+            unsigned long long objetivo;
+            if (config.lecturasPorSegundo > 0.0) {
+                double segundos = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - inicio).count();
+                objetivo = static_cast<unsigned long long>(segundos * config.lecturasPorSegundo);
+            } else {
+                objetivo = emitidas + 512;
+            }
+
+            int usado = 0;
+            while (emitidas < objetivo && usado < CAPACIDAD - 64) {
+                usado += formatearLinea(buffer + usado, CAPACIDAD - usado, rng, u01, ruido);
+                emitidas++;
+            }
+
+            if (usado > 0 && !escribirTodo(buffer, usado)) {
+                break;
+            }
+            lineasEmitidas.store(emitidas, std::memory_order_relaxed);
+
+            if (emitidas >= objetivo) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        delete[] buffer;
+    }
+
+    // El maestro es no bloqueante: si el lector se detiene, el emisor
+    // sigue atento a detener() en lugar de quedar colgado en write()
+    bool escribirTodo(const char* datos, int longitud) {
+        while (longitud > 0) {
+            ssize_t n = write(fdMaestro, datos, longitud);
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EINTR) {
+                    if (!activo.load(std::memory_order_relaxed)) {
+                        return false;
+                    }
+                    struct pollfd pfd;
+                    pfd.fd = fdMaestro;
+                    pfd.events = POLLOUT;
+                    poll(&pfd, 1, 10);
+                    continue;
+                }
+                return false;
+            }
+            datos += n;
+            longitud -= static_cast<int>(n);
+        }
+        return true;
+    }
+};
+
+#endif // GENERADORCARGA_H
@@ -0,0 +1,297 @@
+/**
+ * @file IngestaArduino.h
+ * @brief Procesamiento de una línea de texto recibida del Arduino
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Contiene la ruta de ingesta compartida por la lectura serial interactiva
+ * y por el arnés de carga sintética: parseo de "T ID VALOR" / "P ID VALOR" / "V ID VALOR",
+ * búsqueda o creación del sensor e inserción de la lectura.
+ */
+
+#ifndef INGESTAARDUINO_H
+#define INGESTAARDUINO_H
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "ParserArduino.h"
+#include "ProtocoloBinario.h"
+#include "SensorBase.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "SensorVibracion.h"
+#include "ListaGeneral.h"
+#include "Metricas.h"
+#include "SerialPort.h"
+
+/**
+ * @brief Escribe las series por sensor (lecturas y bytes) en formato Prometheus
+ */
+inline void escribirMetricasSensores(std::ostream& os, ListaGeneral* listaGestion) {
+    os << "# TYPE iot_lecturas_sensor gauge\n";
+    listaGestion->iterar([&os](SensorBase* sensor) {
+        os << "iot_lecturas_sensor{sensor=\"" << sensor->getNombre()
+           << "\",tipo=\"" << sensor->getTipo() << "\"} " << sensor->getNumLecturas() << "\n";
+    });
+    os << "# TYPE iot_memoria_sensor_bytes gauge\n";
+    listaGestion->iterar([&os](SensorBase* sensor) {
+        os << "iot_memoria_sensor_bytes{sensor=\"" << sensor->getNombre()
+           << "\",tipo=\"" << sensor->getTipo() << "\"} " << sensor->getBytesMemoria() << "\n";
+    });
+}
+
+/**
+ * @brief Registra en Metricas el error de parseo correspondiente
+ */
+inline void contarErrorParseo(ResultadoParseo resultado) {
+    switch (resultado) {
+        case ResultadoParseo::SinFormato:       Metricas::incrementar(Contador::ErrorSinFormato); break;
+        case ResultadoParseo::FormatoInvalido:  Metricas::incrementar(Contador::ErrorFormatoInvalido); break;
+        case ResultadoParseo::ValorTemperatura: Metricas::incrementar(Contador::ErrorValorTemperatura); break;
+        case ResultadoParseo::ValorPresion:     Metricas::incrementar(Contador::ErrorValorPresion); break;
+        case ResultadoParseo::ValorVibracion:   Metricas::incrementar(Contador::ErrorValorVibracion); break;
+        case ResultadoParseo::TipoDesconocido:  Metricas::incrementar(Contador::ErrorTipoDesconocido); break;
+        default: break;
+    }
+}
+
+/**
+ * @brief Busca un sensor de @p lista por su ID internado
+ * @return Puntero al sensor o nullptr si no existe en esa lista
+ * @details O(1) mediante el índice de ListaGeneral; reemplaza el recorrido
+ *          de la lista comparando nombres con strcmp.
+ */
+inline SensorBase* buscarSensor(const ListaGeneral* lista, uint32_t simbolo) {
+    return lista->buscarPorId(simbolo);
+}
+
+/**
+ * @brief Agrega @p valor al sensor de tipo @p Sensor, creándolo si no existe
+ * @tparam Sensor Instanciación de SensorTipado (SensorTemperatura, SensorPresion...)
+ * @param llegadaNs Llegada de la lectura al puerto (0 = sin marca)
+ * @details El sensor existente se reconoce por su clase (comoSensor), sin
+ *          dynamic_cast. Si el ID pertenece a un sensor de otro tipo la
+ *          lectura se descarta, igual que antes.
+ */
+template <typename Sensor>
+inline void registrarTipado(ListaGeneral* lista, SensorBase* sensorExistente, const char* id,
+                            typename Sensor::Valor valor, uint64_t llegadaNs) {
+    typedef typename Sensor::MagnitudSensor Magnitud;
+    if (sensorExistente == nullptr) {
+        // Crear nuevo sensor
+        Sensor* nuevoSensor = new Sensor(id);
+        nuevoSensor->agregarLectura(valor, llegadaNs);
+        lista->insertarAlFinal(nuevoSensor);
+        std::cout << "✓ " << Magnitud::nombre() << " '" << id << "' creado" << std::endl;
+        std::cout << "  📊 Tipo de dato: " << Magnitud::nombreValor() << std::endl;
+        std::cout << "  📈 Valor inicial: " << valor << Magnitud::unidad() << std::endl;
+    } else {
+        // Agregar lectura al sensor existente
+        Sensor* sensor = comoSensor<Sensor>(sensorExistente);
+        if (sensor) {
+            sensor->agregarLectura(valor, llegadaNs);
+            std::cout << "✓ Lectura agregada a sensor '" << id << "'" << std::endl;
+            std::cout << "  📊 Tipo de dato: " << Magnitud::nombreValor() << std::endl;
+            std::cout << "  📈 Valor: " << valor << Magnitud::unidad() << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Agrega una lectura válida a su sensor, creándolo si no existe
+ * @param lista Lista de gestión
+ * @param lectura Lectura con resultado == ResultadoParseo::Valida
+ * @param llegadaNs Llegada de los bytes al puerto, para la latencia de las
+ *                  alertas (0 = sin marca, p. ej. ingesta por lotes)
+ * @details Si @c lectura.simbolo no viene resuelto, el ID se interna aquí
+ *          (una búsqueda hash; el texto no vuelve a compararse por sensor).
+ */
+inline void registrarLectura(ListaGeneral* lista, const LecturaArduino& lectura,
+                             uint64_t llegadaNs = 0) {
+    uint32_t simbolo = lectura.simbolo != TablaSimbolos::SIN_ID
+                           ? lectura.simbolo
+                           : TablaSimbolos::global().internar(lectura.id);
+    SensorBase* sensorExistente = buscarSensor(lista, simbolo);
+    
+    if (lectura.tipo == 'T') {
+        registrarTipado<SensorTemperatura>(lista, sensorExistente, lectura.id, lectura.temperatura,
+                                           llegadaNs);
+    } else if (lectura.tipo == 'P') {
+        registrarTipado<SensorPresion>(lista, sensorExistente, lectura.id, lectura.presion,
+                                       llegadaNs);
+    } else {
+        registrarTipado<SensorVibracion>(lista, sensorExistente, lectura.id, lectura.vibracion,
+                                         llegadaNs);
+    }
+}
+
+/**
+ * @brief Interpreta una línea recibida y la registra en la lista de gestión
+ * @param lista Lista de gestión donde se buscan o crean los sensores
+ * @param linea Línea de texto sin el fin de línea
+ * @param inicioNs Marca de tiempo (Metricas::ahoraNs) en que llegaron los
+ *                 bytes de la línea (SerialPort::getMarcaLlegada)
+ * @return true si la línea produjo una lectura válida
+ *
+ * @details
+ * Las líneas de log del Arduino se ignoran sin contarse como error. Los
+ * errores de parseo se registran por categoría en Metricas y la latencia
+ * desde @p inicioNs hasta la inserción se observa en
+ * Histograma::LatenciaIngesta.
+ */
+inline bool procesarLineaArduino(ListaGeneral* lista, const std::string& linea, uint64_t inicioNs) {
+    LecturaArduino lectura;
+    parsearLineaArduino(linea.data(), linea.data() + linea.size(), lectura);
+    
+    switch (lectura.resultado) {
+        case ResultadoParseo::Valida:
+            std::cout << "📡 Recibido: " << linea << std::endl;
+            registrarLectura(lista, lectura, inicioNs);
+            Metricas::observar(Histograma::LatenciaIngesta, Metricas::ahoraNs() - inicioNs);
+            return true;
+        
+        case ResultadoParseo::Ignorada:
+            return false;
+        
+        case ResultadoParseo::SinFormato:
+            std::cout << "📡 Recibido: " << linea << std::endl;
+            if (lectura.tienePunto) {
+                std::cout << "⚠️  Dato recibido sin formato: " << lectura.numeroSinFormato << std::endl;
+                std::cout << "   📊 Tipo detectado: float (tiene punto decimal)" << std::endl;
+            } else {
+                std::cout << "⚠️  Dato recibido sin formato: " << (int)lectura.numeroSinFormato << std::endl;
+                std::cout << "   📊 Tipo detectado: int (sin punto decimal)" << std::endl;
+            }
+            std::cout << "   💡 Formato esperado: T ID VALOR,  P ID VALOR  o  V ID VALOR" << std::endl;
+            break;
+        
+        case ResultadoParseo::FormatoInvalido:
+            std::cout << "📡 Recibido: " << linea << std::endl;
+            std::cout << "⚠️  Formato inválido, ignorando..." << std::endl;
+            break;
+        
+        case ResultadoParseo::ValorTemperatura:
+            std::cout << "📡 Recibido: " << linea << std::endl;
+            std::cout << "⚠️  Valor de temperatura inválido" << std::endl;
+            break;
+        
+        case ResultadoParseo::ValorPresion:
+            std::cout << "📡 Recibido: " << linea << std::endl;
+            std::cout << "⚠️  Valor de presión inválido" << std::endl;
+            break;
+        
+        case ResultadoParseo::ValorVibracion:
+            std::cout << "📡 Recibido: " << linea << std::endl;
+            std::cout << "⚠️  Valor de vibración inválido" << std::endl;
+            break;
+        
+        case ResultadoParseo::TipoDesconocido:
+            std::cout << "📡 Recibido: " << linea << std::endl;
+            std::cout << "⚠️  Tipo de sensor desconocido: " << lectura.tipo << std::endl;
+            break;
+    }
+    
+    contarErrorParseo(lectura.resultado);
+    return false;
+}
+
+/**
+ * @brief ID internado del sensor de una trama, con caché por (tipo, índice)
+ * @param trama Trama decodificada
+ * @param id Texto equivalente ("T-007"), usado sólo la primera vez
+ * @details El internado se resuelve una vez por sensor y después es un
+ *          acceso a un arreglo por tipo, que crece por duplicación hasta el
+ *          mayor índice visto. Se usa desde el hilo de ingesta.
+ */
+inline uint32_t simboloTrama(const TramaBinaria& trama, const char* id) {
+    struct Cache {
+        uint32_t* simbolos[2];
+        uint32_t capacidad[2];
+        Cache() {
+            for (int t = 0; t < 2; t++) {
+                simbolos[t] = nullptr;
+                capacidad[t] = 0;
+            }
+        }
+        ~Cache() {
+            delete[] simbolos[0];
+            delete[] simbolos[1];
+        }
+        void crecer(int t, uint32_t indice) {
+            uint32_t nueva = capacidad[t] == 0 ? 256 : capacidad[t];
+            while (nueva <= indice) {
+                nueva *= 2;
+            }
+            uint32_t* mayor = new uint32_t[nueva];
+            for (uint32_t i = 0; i < nueva; i++) {
+                mayor[i] = i < capacidad[t] ? simbolos[t][i] : TablaSimbolos::SIN_ID;
+            }
+            delete[] simbolos[t];
+            simbolos[t] = mayor;
+            capacidad[t] = nueva;
+        }
+    };
+    static Cache cache;
+    int t = trama.tipo == 'T' ? 0 : 1;
+    if (trama.indice >= cache.capacidad[t]) {
+        cache.crecer(t, trama.indice);
+    }
+    uint32_t& simbolo = cache.simbolos[t][trama.indice];
+    if (simbolo == TablaSimbolos::SIN_ID) {
+        simbolo = TablaSimbolos::global().internar(id);
+    }
+    return simbolo;
+}
+
+/**
+ * @brief Registra la lectura contenida en una trama binaria ya validada
+ * @param lista Lista de gestión
+ * @param trama Trama decodificada por DecodificadorBinario
+ * @param inicioNs Marca de tiempo en que llegaron los bytes (SerialPort::getMarcaLlegada)
+ */
+inline void procesarTramaBinaria(ListaGeneral* lista, const TramaBinaria& trama, uint64_t inicioNs) {
+    LecturaArduino lectura;
+    ProtocoloBinario::aLectura(trama, lectura);
+    lectura.simbolo = simboloTrama(trama, lectura.id);
+    std::cout << "📡 Trama: " << lectura.id << " " << trama.valor << std::endl;
+    registrarLectura(lista, lectura, inicioNs);
+    Metricas::observar(Histograma::LatenciaIngesta, Metricas::ahoraNs() - inicioNs);
+}
+
+/**
+ * @brief Acuerda el formato con el Arduino
+ * @param puerto Puerto ya abierto
+ * @param solicitado Modo elegido por el usuario
+ * @return Modo efectivo (nunca Automatico)
+ *
+ * @details
+ * En modo Binario se envía el comando de activación. En modo Automatico
+ * se observan los primeros bytes sin consumirlos hasta reconocer tramas
+ * o líneas; si el búfer se llena sin evidencia se asume texto.
+ */
+inline ModoProtocolo negociarProtocolo(SerialPort& puerto, ModoProtocolo solicitado) {
+    if (solicitado == ModoProtocolo::Binario) {
+        const char* comando = ProtocoloBinario::comandoActivar();
+        puerto.escribir(comando, std::strlen(comando));
+        return ModoProtocolo::Binario;
+    }
+    if (solicitado == ModoProtocolo::Texto) {
+        return ModoProtocolo::Texto;
+    }
+    
+    ModoProtocolo detectado = ModoProtocolo::Texto;
+    size_t minimo = ProtocoloBinario::LONGITUD_TRAMA * 2;
+    while (true) {
+        const unsigned char* datos;
+        size_t disponibles = puerto.espiar(&datos, minimo);
+        if (ProtocoloBinario::detectar(datos, disponibles, detectado) ||
+            disponibles < minimo || disponibles >= SerialPort::TAMANIO_BUFFER) {
+            return detectado;
+        }
+        minimo = disponibles + 1;
+    }
+}
+
+#endif // INGESTAARDUINO_H
@@ -0,0 +1,103 @@
+/**
+ * @file ListaGeneral.h
+ * @brief Lista de gestión de sensores con índice por ID internado
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ */
+
+#ifndef LISTAGENERAL_H
+#define LISTAGENERAL_H
+
+#include <cstdint>
+#include "ListaSensor.h"
+#include "SensorBase.h"
+
+/**
+ * @class ListaGeneral
+ * @brief Lista de gestión con un índice propio ID internado -> sensor
+ *
+ * @details
+ * Contiene (no hereda) un ListaSensor<SensorBase*>: la única forma de
+ * insertar es insertarAlFinal() de esta clase, que siempre indexa, así que
+ * las vistas del almacén columnar y los sensores creados por la ingesta
+ * quedan visibles para buscarPorId() por igual.
+ *
+ * buscarPorId() sólo encuentra sensores insertados en esta lista: una
+ * flota de prueba o un sensor con el mismo nombre en otra lista no la
+ * afectan. El índice sigue las reglas de la lista (un solo hilo la
+ * modifica y consulta); listas distintas pueden usarse desde hilos
+ * distintos.
+ *
+ * @note Los sensores se liberan junto con la lista, no de a uno.
+ */
+class ListaGeneral {
+private:
+    ListaSensor<SensorBase*> sensores;
+    SensorBase** porId;      // Arreglo denso ID -> sensor (crece por duplicación)
+    uint32_t capacidadIds;
+
+public:
+    ListaGeneral() : porId(nullptr), capacidadIds(0) {}
+
+    ~ListaGeneral() {
+        delete[] porId;
+    }
+
+    ListaGeneral(const ListaGeneral&) = delete;
+    ListaGeneral& operator=(const ListaGeneral&) = delete;
+
+    /**
+     * @brief Inserta al final e indexa el sensor por su ID
+     * @details Si la lista ya tenía un sensor con ese ID, la búsqueda
+     *          pasa a devolver el nuevo.
+     */
+    void insertarAlFinal(SensorBase* sensor) {
+        sensores.insertarAlFinal(sensor);
+        uint32_t id = sensor->getId();
+        if (id >= capacidadIds) {
+            crecer(id);
+        }
+        porId[id] = sensor;
+    }
+
+    /**
+     * @brief Sensor de esta lista con el ID internado @p id
+     * @return Puntero al sensor, o nullptr (también para TablaSimbolos::SIN_ID)
+     * @details O(1): un acceso al arreglo indexado por ID
+     */
+    SensorBase* buscarPorId(uint32_t id) const {
+        return id < capacidadIds ? porId[id] : nullptr;
+    }
+
+    // Aplicar una función a cada sensor, en orden de inserción
+    template <typename Funcion>
+    void iterar(Funcion f) const {
+        sensores.iterar(f);
+    }
+
+    int getTamanio() const {
+        return sensores.getTamanio();
+    }
+
+    bool estaVacia() const {
+        return sensores.estaVacia();
+    }
+
+private:
+    void crecer(uint32_t id) {
+        uint32_t nueva = capacidadIds == 0 ? 32 : capacidadIds;
+        while (nueva <= id) {
+            nueva *= 2;
+        }
+        SensorBase** mayor = new SensorBase*[nueva];
+        for (uint32_t i = 0; i < nueva; i++) {
+            mayor[i] = i < capacidadIds ? porId[i] : nullptr;
+        }
+        delete[] porId;
+        porId = mayor;
+        capacidadIds = nueva;
+    }
+};
+
+#endif // LISTAGENERAL_H
@@ -2,27 +2,45 @@
 #define LISTASENSOR_H
 
 #include "Nodo.h"
+#include "MemoriaHeap.h"
+#include "Metricas.h"
 #include <iostream>
+#include <new>
 
 /**
  * Clase de Lista Enlazada Simple Genérica
  * Implementa operaciones básicas de inserción, búsqueda y liberación
  * Cumple con la Regla de los Tres/Cinco para gestión de memoria
+ *
+ * Lleva la cuenta de los bytes reservados (nodos con la cabecera del
+ * asignador) y puede compactarse: compactar() reescribe los nodos en un
+ * único bloque contiguo. Los nodos del bloque no se liberan uno a uno;
+ * al eliminarse pasan a una lista de libres que reutilizan las
+ * inserciones siguientes.
  */
 template <typename T>
 class ListaSensor {
 private:
     Nodo<T>* cabeza;  // Puntero al primer nodo
+    Nodo<T>* cola;    // Puntero al último nodo (inserción al final en O(1))
     int tamanio;      // Número de elementos en la lista
+    Nodo<T>* bloque;  // Nodos contiguos creados por compactar() (o nullptr)
+    int nodosBloque;  // Capacidad de bloque
+    Nodo<T>* libres;  // Nodos de bloque sin usar, enlazados por siguiente
+    size_t bytes;     // Bytes reservados por nodos y bloque
     
 public:
     // Constructor por defecto
-    ListaSensor() : cabeza(nullptr), tamanio(0) {
+    ListaSensor()
+        : cabeza(nullptr), cola(nullptr), tamanio(0), bloque(nullptr), nodosBloque(0),
+          libres(nullptr), bytes(0) {
         std::cout << "[ListaSensor] Constructor - Lista creada" << std::endl;
     }
     
     // Constructor de copia
-    ListaSensor(const ListaSensor& otra) : cabeza(nullptr), tamanio(0) {
+    ListaSensor(const ListaSensor& otra)
+        : cabeza(nullptr), cola(nullptr), tamanio(0), bloque(nullptr), nodosBloque(0),
+          libres(nullptr), bytes(0) {
         std::cout << "[ListaSensor] Constructor de copia" << std::endl;
         copiar(otra);
     }
@@ -45,21 +63,141 @@ public:
     
     // Insertar al final de la lista
     void insertarAlFinal(T dato) {
-        Nodo<T>* nuevo = new Nodo<T>(dato);
+        Nodo<T>* nuevo;
+        if (libres != nullptr) {
+            nuevo = libres;
+            libres = libres->siguiente;
+            nuevo->dato = dato;
+            nuevo->siguiente = nullptr;
+            Metricas::incrementar(Contador::NodosReutilizados);
+        } else {
+            nuevo = new Nodo<T>(dato);
+            bytes += costoNodo();
+            Metricas::incrementar(Contador::NodosCreados);
+        }
         
         if (cabeza == nullptr) {
             cabeza = nuevo;
         } else {
-            Nodo<T>* actual = cabeza;
-            while (actual->siguiente != nullptr) {
-                actual = actual->siguiente;
-            }
-            actual->siguiente = nuevo;
+            cola->siguiente = nuevo;
         }
+        cola = nuevo;
         tamanio++;
         std::cout << "[Log] Insertando Nodo<" << typeid(T).name() << ">" << std::endl;
     }
     
+    /**
+     * @brief Inserta al final sin superar @p presupuesto bytes
+     * @param presupuesto Máximo de bytes reservados (0 = sin límite)
+     * @return Cantidad de elementos antiguos eliminados para hacer lugar
+     * @details Antes de reservar un nodo nuevo elimina los más antiguos
+     *          hasta que quepa o haya un nodo libre del bloque compactado.
+     *          Si el bloque compactado ya supera el presupuesto, elimina
+     *          hasta que el resto quepa en nodos sueltos y abandona el
+     *          bloque (ver descompactar()). Siempre conserva al menos el
+     *          elemento insertado.
+     */
+    int insertarAcotado(T dato, size_t presupuesto) {
+        int eliminados = 0;
+        if (presupuesto > 0) {
+            if (bloque != nullptr && bytes > presupuesto) {
+                // Reutilizar los libres del bloque nunca bajaría de su tamaño
+                while (cabeza != nullptr && (tamanio + 1) * costoNodo() > presupuesto) {
+                    eliminarPrimero();
+                    eliminados++;
+                }
+                descompactar();
+            }
+            while (libres == nullptr && cabeza != nullptr && bytes + costoNodo() > presupuesto) {
+                eliminarPrimero();
+                eliminados++;
+            }
+        }
+        insertarAlFinal(dato);
+        return eliminados;
+    }
+    
+    // Eliminar el primer (más antiguo) elemento de la lista
+    void eliminarPrimero() {
+        if (cabeza == nullptr) {
+            return;
+        }
+        Nodo<T>* temp = cabeza;
+        cabeza = cabeza->siguiente;
+        if (cabeza == nullptr) {
+            cola = nullptr;
+        }
+        std::cout << "[Log] Nodo<" << typeid(T).name() << "> liberado" << std::endl;
+        liberarNodo(temp);
+        tamanio--;
+    }
+    
+    /**
+     * @brief Reescribe todos los nodos en un único bloque contiguo
+     * @details El recorrido pasa a ser secuencial en memoria y se ahorra
+     *          la cabecera y el redondeo del asignador de cada nodo. El
+     *          orden y los datos no cambian. O(n), u O(1) si la lista ya
+     *          ocupa exactamente su bloque (sin nodos sueltos ni libres).
+     */
+    void compactar() {
+        if (tamanio == 0) {
+            liberarBloque();
+            return;
+        }
+        if (bloque != nullptr && libres == nullptr && tamanio == nodosBloque) {
+            return;   // Todos los nodos de la lista son los del bloque
+        }
+        Nodo<T>* nuevoBloque = static_cast<Nodo<T>*>(::operator new(sizeof(Nodo<T>) * tamanio));
+        int i = 0;
+        for (Nodo<T>* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            new (&nuevoBloque[i]) Nodo<T>(actual->dato);
+            if (i > 0) {
+                nuevoBloque[i - 1].siguiente = &nuevoBloque[i];
+            }
+            i++;
+        }
+        
+        // Liberar los nodos sueltos y el bloque anterior
+        Nodo<T>* actual = cabeza;
+        while (actual != nullptr) {
+            Nodo<T>* siguiente = actual->siguiente;
+            if (!enBloque(actual)) {
+                delete actual;
+                Metricas::incrementar(Contador::NodosLiberados);
+            }
+            actual = siguiente;
+        }
+        liberarBloque();
+        
+        bloque = nuevoBloque;
+        nodosBloque = tamanio;
+        cabeza = &bloque[0];
+        cola = &bloque[tamanio - 1];
+        bytes = MemoriaHeap::costo(bloque, sizeof(Nodo<T>) * tamanio);
+    }
+    
+    /**
+     * @brief Bytes reservados por los nodos (cabecera del asignador incluida)
+     * @details O(1): se actualiza en cada inserción, eliminación y compactación
+     */
+    size_t getBytes() const {
+        return bytes;
+    }
+    
+    // Indica si la lista tiene nodos en un bloque compactado
+    bool estaCompactada() const {
+        return bloque != nullptr;
+    }
+    
+    /**
+     * @brief Costo real de un nodo reservado individualmente
+     * @details Se mide una sola vez con un nodo de prueba
+     */
+    static size_t costoNodo() {
+        static const size_t costo = medirNodo();
+        return costo;
+    }
+    
     // Buscar un elemento en la lista
     Nodo<T>* buscar(T dato) const {
         Nodo<T>* actual = cabeza;
@@ -103,12 +241,72 @@ public:
             Nodo<T>* temp = cabeza;
             cabeza = cabeza->siguiente;
             std::cout << "[Log] Nodo<" << typeid(T).name() << "> liberado" << std::endl;
-            delete temp;
+            liberarNodo(temp);
             tamanio--;
         }
+        cola = nullptr;
+        liberarBloque();
     }
     
 private:
+    bool enBloque(const Nodo<T>* nodo) const {
+        return bloque != nullptr && nodo >= bloque && nodo < bloque + nodosBloque;
+    }
+    
+    // Los nodos del bloque vuelven a la lista de libres; el resto se libera.
+    // NodosCreados / NodosLiberados cuentan sólo reservas y liberaciones reales
+    void liberarNodo(Nodo<T>* nodo) {
+        if (enBloque(nodo)) {
+            nodo->siguiente = libres;
+            libres = nodo;
+        } else {
+            delete nodo;
+            bytes -= costoNodo();
+            Metricas::incrementar(Contador::NodosLiberados);
+        }
+    }
+    
+    // Copia los nodos del bloque a nodos sueltos y libera el bloque. O(n)
+    void descompactar() {
+        Nodo<T>* anterior = nullptr;
+        Nodo<T>* actual = cabeza;
+        while (actual != nullptr) {
+            Nodo<T>* siguiente = actual->siguiente;
+            Nodo<T>* nodo = actual;
+            if (enBloque(actual)) {
+                nodo = new Nodo<T>(actual->dato);
+                bytes += costoNodo();
+                Metricas::incrementar(Contador::NodosCreados);
+            }
+            if (anterior == nullptr) {
+                cabeza = nodo;
+            } else {
+                anterior->siguiente = nodo;
+            }
+            anterior = nodo;
+            actual = siguiente;
+        }
+        cola = anterior;
+        liberarBloque();
+    }
+    
+    void liberarBloque() {
+        if (bloque != nullptr) {
+            bytes -= MemoriaHeap::costo(bloque, sizeof(Nodo<T>) * nodosBloque);
+            ::operator delete(bloque);
+        }
+        bloque = nullptr;
+        nodosBloque = 0;
+        libres = nullptr;
+    }
+    
+    static size_t medirNodo() {
+        Nodo<T>* prueba = new Nodo<T>(T());
+        size_t costo = MemoriaHeap::costo(prueba, sizeof(Nodo<T>));
+        delete prueba;
+        return costo;
+    }
+    
     // Función auxiliar para copiar otra lista
     void copiar(const ListaSensor& otra) {
         if (otra.cabeza == nullptr) {
@@ -0,0 +1,71 @@
+/**
+ * @file MemoriaHeap.h
+ * @brief Tamaño real de los bloques reservados en el heap
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Un Nodo<float> ocupa 16 bytes, pero el asignador entrega un bloque
+ * redondeado y le antepone una cabecera. La contabilidad de memoria de
+ * los sensores usa estas funciones para reportar el costo verdadero y no
+ * sólo sizeof().
+ */
+
+#ifndef MEMORIAHEAP_H
+#define MEMORIAHEAP_H
+
+#include <cstddef>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+/**
+ * @class MemoriaHeap
+ * @brief Consulta al asignador el tamaño utilizable de un bloque
+ *
+ * @details
+ * Con glibc se usa malloc_usable_size() y con macOS malloc_size(); en
+ * otras plataformas se estima con el redondeo a 16 bytes de glibc. A lo
+ * utilizable se suma la cabecera del asignador (un size_t por bloque).
+ *
+ * @note Sólo debe pasarse un puntero devuelto por new/malloc. Para objetos
+ *       que pueden vivir en la pila se usa estimar().
+ */
+class MemoriaHeap {
+public:
+    static const size_t CABECERA = sizeof(size_t);   ///< Cabecera del asignador por bloque
+
+    /**
+     * @brief Bytes que consume el bloque @p puntero, cabecera incluida
+     * @param puntero Bloque reservado con new/malloc (nullptr = 0 bytes)
+     * @param pedido Bytes solicitados (usado si no se puede consultar)
+     */
+    static size_t costo(const void* puntero, size_t pedido) {
+        if (puntero == nullptr) {
+            return 0;
+        }
+#if defined(__GLIBC__)
+        (void)pedido;
+        return malloc_usable_size(const_cast<void*>(puntero)) + CABECERA;
+#elif defined(__APPLE__)
+        (void)pedido;
+        return malloc_size(puntero) + CABECERA;
+#else
+        return estimar(pedido);
+#endif
+    }
+
+    /**
+     * @brief Estimación del costo de reservar @p pedido bytes
+     * @details Bloques múltiplos de 16 con un mínimo de 32 bytes, como glibc
+     */
+    static size_t estimar(size_t pedido) {
+        size_t bloque = (pedido + CABECERA + 15) & ~static_cast<size_t>(15);
+        return bloque < 32 ? 32 : bloque;
+    }
+};
+
+#endif // MEMORIAHEAP_H
@@ -0,0 +1,396 @@
+/**
+ * @file Metricas.h
+ * @brief Subsistema de métricas de bajo costo para la ruta de ingesta
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Define contadores e histogramas por hilo que se agregan bajo demanda
+ * y se exportan en formato de texto compatible con Prometheus.
+ */
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * @enum Contador
+ * @brief Contadores monótonos registrados por el sistema
+ */
+enum class Contador : int {
+    LineasLeidas = 0,        ///< Líneas completas entregadas por SerialPort
+    BytesLeidos,             ///< Bytes leídos del puerto serial
+    ErrorSinFormato,         ///< Línea numérica sin "TIPO ID"
+    ErrorFormatoInvalido,    ///< Línea que no se pudo interpretar
+    ErrorValorTemperatura,   ///< Valor de temperatura no numérico
+    ErrorValorPresion,       ///< Valor de presión no numérico
+    ErrorValorVibracion,     ///< Valor de vibración no numérico
+    ErrorTipoDesconocido,    ///< Tipo de sensor distinto de T/P/V
+    NodosCreados,            ///< Nodos reservados por ListaSensor
+    NodosLiberados,          ///< Nodos liberados por ListaSensor
+    NodosReutilizados,       ///< Inserciones en un nodo libre del bloque compactado (sin reservar)
+    LecturasTemperatura,     ///< Lecturas insertadas en sensores T
+    LecturasPresion,         ///< Lecturas insertadas en sensores P
+    LecturasVibracion,       ///< Lecturas insertadas en sensores V
+    TramasBinarias,          ///< Tramas binarias con CRC válido
+    TramasCorruptas,         ///< Tramas binarias descartadas (tipo o CRC)
+    BytesDescartados,        ///< Bytes ignorados al resincronizar
+    AlertasUmbral,           ///< Alertas de MotorReglas por umbral
+    AlertasCambio,           ///< Alertas de MotorReglas por tasa de cambio
+    AlertasVentana,          ///< Alertas de MotorReglas por ventana N de M
+    AlertasInactividad,      ///< Alertas de MotorReglas por sensor inactivo
+    LecturasExpulsadas,      ///< Lecturas antiguas descartadas por presupuesto de memoria
+    LecturasExportadas,      ///< Lecturas escritas por ExportadorLecturas
+    ExportacionDescartadas,  ///< Lecturas no exportadas porque el escritor iba atrasado
+    BytesExportados,         ///< Bytes escritos en los archivos de exportación
+    NUM_CONTADORES
+};
+
+/**
+ * @enum Histograma
+ * @brief Histogramas de latencia registrados por el sistema
+ */
+enum class Histograma : int {
+    LatenciaIngesta = 0,     ///< Nanosegundos entre la llegada de los bytes al puerto e inserción
+    LatenciaAlerta,          ///< Nanosegundos entre la llegada de la lectura al puerto y la alerta
+    NUM_HISTOGRAMAS
+};
+
+/**
+ * @struct InstantaneaMetricas
+ * @brief Suma de los bloques de todos los hilos en un instante dado
+ *
+ * @details
+ * Los histogramas usan cubetas logarítmicas en base 2: la cubeta @c i
+ * contiene los valores @c v con @c 2^(i-1) <= v < 2^i (la cubeta 0
+ * contiene únicamente el cero).
+ */
+struct InstantaneaMetricas {
+    static const int NUM_CONTADORES = static_cast<int>(Contador::NUM_CONTADORES);
+    static const int NUM_HISTOGRAMAS = static_cast<int>(Histograma::NUM_HISTOGRAMAS);
+    static const int NUM_CUBETAS = 64;
+
+    uint64_t contadores[NUM_CONTADORES];
+    uint64_t cubetas[NUM_HISTOGRAMAS][NUM_CUBETAS];
+    uint64_t suma[NUM_HISTOGRAMAS];
+    uint64_t cuenta[NUM_HISTOGRAMAS];
+
+    InstantaneaMetricas() {
+        for (int i = 0; i < NUM_CONTADORES; i++) contadores[i] = 0;
+        for (int h = 0; h < NUM_HISTOGRAMAS; h++) {
+            for (int i = 0; i < NUM_CUBETAS; i++) cubetas[h][i] = 0;
+            suma[h] = 0;
+            cuenta[h] = 0;
+        }
+    }
+
+    uint64_t valor(Contador c) const {
+        return contadores[static_cast<int>(c)];
+    }
+
+    /**
+     * @brief Estima un percentil a partir de las cubetas del histograma
+     * @param h Histograma a consultar
+     * @param p Percentil en el rango [0, 1]
+     * @return Cota superior de la cubeta que contiene el percentil
+     */
+    uint64_t percentil(Histograma h, double p) const {
+        int idx = static_cast<int>(h);
+        if (cuenta[idx] == 0) {
+            return 0;
+        }
+        uint64_t objetivo = static_cast<uint64_t>(p * cuenta[idx]);
+        if (objetivo >= cuenta[idx]) objetivo = cuenta[idx] - 1;
+        uint64_t acumulado = 0;
+        for (int i = 0; i < NUM_CUBETAS; i++) {
+            acumulado += cubetas[idx][i];
+            if (acumulado > objetivo) {
+                return i == 0 ? 0 : (uint64_t(1) << i) - 1;
+            }
+        }
+        return UINT64_MAX;
+    }
+};
+
+/**
+ * @struct BloqueMetricas
+ * @brief Contadores privados de un hilo
+ *
+ * @details
+ * Sólo el hilo dueño escribe en su bloque, por lo que las actualizaciones
+ * son un load/store relajado sin instrucciones de bus bloqueado. El
+ * agregador lee los bloques de todos los hilos con cargas relajadas.
+ * Los bloques forman una lista enlazada simple que nunca se libera, de
+ * modo que los conteos de hilos terminados se conservan.
+ */
+struct BloqueMetricas {
+    std::atomic<uint64_t> contadores[InstantaneaMetricas::NUM_CONTADORES];
+    std::atomic<uint64_t> cubetas[InstantaneaMetricas::NUM_HISTOGRAMAS][InstantaneaMetricas::NUM_CUBETAS];
+    std::atomic<uint64_t> suma[InstantaneaMetricas::NUM_HISTOGRAMAS];
+    std::atomic<uint64_t> cuenta[InstantaneaMetricas::NUM_HISTOGRAMAS];
+    BloqueMetricas* siguiente;
+
+    BloqueMetricas() : siguiente(nullptr) {
+        for (int i = 0; i < InstantaneaMetricas::NUM_CONTADORES; i++) {
+            contadores[i].store(0, std::memory_order_relaxed);
+        }
+        for (int h = 0; h < InstantaneaMetricas::NUM_HISTOGRAMAS; h++) {
+            for (int i = 0; i < InstantaneaMetricas::NUM_CUBETAS; i++) {
+                cubetas[h][i].store(0, std::memory_order_relaxed);
+            }
+            suma[h].store(0, std::memory_order_relaxed);
+            cuenta[h].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @class Metricas
+ * @brief Punto de acceso global a los contadores por hilo
+ *
+ * Ejemplo de uso:
+ * @code
+ * Metricas::incrementar(Contador::LineasLeidas);
+ * Metricas::observar(Histograma::LatenciaIngesta, nanosegundos);
+ * InstantaneaMetricas snap = Metricas::instantanea();
+ * @endcode
+ */
+class Metricas {
+public:
+    /**
+     * @brief Suma @p n al contador @p c del hilo actual
+     */
+    static void incrementar(Contador c, uint64_t n = 1) {
+        sumarRelajado(bloqueLocal()->contadores[static_cast<int>(c)], n);
+    }
+
+    /**
+     * @brief Registra una observación en el histograma @p h del hilo actual
+     */
+    static void observar(Histograma h, uint64_t valor) {
+        BloqueMetricas* b = bloqueLocal();
+        int idx = static_cast<int>(h);
+        int cubeta = anchoBits(valor);
+        sumarRelajado(b->cubetas[idx][cubeta], 1);
+        sumarRelajado(b->suma[idx], valor);
+        sumarRelajado(b->cuenta[idx], 1);
+    }
+
+    /**
+     * @brief Agrega los bloques de todos los hilos
+     * @return Copia consistente por celda (no atómica entre celdas)
+     */
+    static InstantaneaMetricas instantanea() {
+        InstantaneaMetricas snap;
+        BloqueMetricas* b = cabeza().load(std::memory_order_acquire);
+        while (b != nullptr) {
+            for (int i = 0; i < InstantaneaMetricas::NUM_CONTADORES; i++) {
+                snap.contadores[i] += b->contadores[i].load(std::memory_order_relaxed);
+            }
+            for (int h = 0; h < InstantaneaMetricas::NUM_HISTOGRAMAS; h++) {
+                for (int i = 0; i < InstantaneaMetricas::NUM_CUBETAS; i++) {
+                    snap.cubetas[h][i] += b->cubetas[h][i].load(std::memory_order_relaxed);
+                }
+                snap.suma[h] += b->suma[h].load(std::memory_order_relaxed);
+                snap.cuenta[h] += b->cuenta[h].load(std::memory_order_relaxed);
+            }
+            b = b->siguiente;
+        }
+        return snap;
+    }
+
+    /**
+     * @brief Escribe una instantánea en formato de exposición de Prometheus
+     * @param os Flujo de salida
+     * @param snap Instantánea agregada
+     */
+    static void exportarPrometheus(std::ostream& os, const InstantaneaMetricas& snap) {
+        static const char* const nombres[InstantaneaMetricas::NUM_CONTADORES] = {
+            "iot_serial_lineas_total",
+            "iot_serial_bytes_total",
+            "iot_parseo_errores_total{categoria=\"sin_formato\"}",
+            "iot_parseo_errores_total{categoria=\"formato_invalido\"}",
+            "iot_parseo_errores_total{categoria=\"valor_temperatura\"}",
+            "iot_parseo_errores_total{categoria=\"valor_presion\"}",
+            "iot_parseo_errores_total{categoria=\"valor_vibracion\"}",
+            "iot_parseo_errores_total{categoria=\"tipo_desconocido\"}",
+            "iot_nodos_creados_total",
+            "iot_nodos_liberados_total",
+            "iot_nodos_reutilizados_total",
+            "iot_lecturas_total{tipo=\"T\"}",
+            "iot_lecturas_total{tipo=\"P\"}",
+            "iot_lecturas_total{tipo=\"V\"}",
+            "iot_tramas_binarias_total",
+            "iot_tramas_corruptas_total",
+            "iot_bytes_descartados_total",
+            "iot_alertas_total{regla=\"umbral\"}",
+            "iot_alertas_total{regla=\"cambio\"}",
+            "iot_alertas_total{regla=\"ventana\"}",
+            "iot_alertas_total{regla=\"inactividad\"}",
+            "iot_lecturas_expulsadas_total",
+            "iot_exportacion_lecturas_total",
+            "iot_exportacion_descartadas_total",
+            "iot_exportacion_bytes_total"
+        };
+        static const char* const tipos[InstantaneaMetricas::NUM_CONTADORES] = {
+            "iot_serial_lineas_total", "iot_serial_bytes_total",
+            "iot_parseo_errores_total", nullptr, nullptr, nullptr, nullptr, nullptr,
+            "iot_nodos_creados_total", "iot_nodos_liberados_total", "iot_nodos_reutilizados_total",
+            "iot_lecturas_total", nullptr, nullptr,
+            "iot_tramas_binarias_total", "iot_tramas_corruptas_total",
+            "iot_bytes_descartados_total",
+            "iot_alertas_total", nullptr, nullptr, nullptr,
+            "iot_lecturas_expulsadas_total",
+            "iot_exportacion_lecturas_total",
+            "iot_exportacion_descartadas_total",
+            "iot_exportacion_bytes_total"
+        };
+
+        for (int i = 0; i < InstantaneaMetricas::NUM_CONTADORES; i++) {
+            if (tipos[i] != nullptr) {
+                os << "# TYPE " << tipos[i] << " counter\n";
+            }
+            os << nombres[i] << " " << snap.contadores[i] << "\n";
+        }
+
+        // Ingesta: cubetas de 1 µs (2^10 ns) a ~17 s (2^34 ns)
+        // Alertas: cubetas de 128 ns (2^7 ns) a ~17 s
+        static const char* const histogramas[InstantaneaMetricas::NUM_HISTOGRAMAS] = {
+            "iot_latencia_ingesta_segundos",
+            "iot_latencia_alerta_segundos"
+        };
+        static const int primeraCubeta[InstantaneaMetricas::NUM_HISTOGRAMAS] = { 10, 7 };
+
+        for (int h = 0; h < InstantaneaMetricas::NUM_HISTOGRAMAS; h++) {
+            const char* nombre = histogramas[h];
+            os << "# TYPE " << nombre << " histogram\n";
+            uint64_t acumulado = snap.cubetas[h][0];
+            for (int i = 1; i < InstantaneaMetricas::NUM_CUBETAS; i++) {
+                acumulado += snap.cubetas[h][i];
+                if (i < primeraCubeta[h] || i > 34) {
+                    continue;
+                }
+                char limite[32];
+                std::snprintf(limite, sizeof(limite), "%.9g",
+                              static_cast<double>(uint64_t(1) << i) / 1e9);
+                os << nombre << "_bucket{le=\"" << limite << "\"} " << acumulado << "\n";
+            }
+            os << nombre << "_bucket{le=\"+Inf\"} " << snap.cuenta[h] << "\n";
+            char suma[32];
+            std::snprintf(suma, sizeof(suma), "%.9f", static_cast<double>(snap.suma[h]) / 1e9);
+            os << nombre << "_sum " << suma << "\n";
+            os << nombre << "_count " << snap.cuenta[h] << "\n";
+        }
+    }
+
+    /**
+     * @brief Marca de tiempo monótona en nanosegundos
+     */
+    static uint64_t ahoraNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+private:
+    static void sumarRelajado(std::atomic<uint64_t>& celda, uint64_t n) {
+        celda.store(celda.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static int anchoBits(uint64_t v) {
+        int bits = 0;
+        while (v != 0) {
+            v >>= 1;
+            bits++;
+        }
+        return bits < InstantaneaMetricas::NUM_CUBETAS ? bits : InstantaneaMetricas::NUM_CUBETAS - 1;
+    }
+
+    static std::atomic<BloqueMetricas*>& cabeza() {
+        static std::atomic<BloqueMetricas*> lista(nullptr);
+        return lista;
+    }
+
+    // Registra perezosamente el bloque del hilo actual en la lista global
+    static BloqueMetricas* bloqueLocal() {
+        static thread_local BloqueMetricas* bloque = nullptr;
+        if (bloque == nullptr) {
+            bloque = new BloqueMetricas();
+            BloqueMetricas* anterior = cabeza().load(std::memory_order_relaxed);
+            do {
+                bloque->siguiente = anterior;
+            } while (!cabeza().compare_exchange_weak(anterior, bloque,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed));
+        }
+        return bloque;
+    }
+};
+
+/**
+ * @class ExportadorMetricas
+ * @brief Vuelca periódicamente las métricas a un archivo de texto
+ *
+ * @details
+ * No usa hilos propios: el lazo de ingesta llama a exportarSiCorresponde()
+ * y el volcado se realiza en el mismo hilo que modifica las listas, por lo
+ * que recorrer los sensores no requiere sincronización. El archivo se
+ * escribe en uno temporal y se renombra para que los lectores nunca vean
+ * un volcado a medias.
+ */
+class ExportadorMetricas {
+private:
+    std::string ruta;
+    uint64_t intervaloNs;
+    uint64_t ultimoNs;
+
+public:
+    ExportadorMetricas(const std::string& archivo = "metricas.prom", int intervaloSegundos = 10)
+        : ruta(archivo),
+          intervaloNs(static_cast<uint64_t>(intervaloSegundos) * 1000000000ULL),
+          ultimoNs(Metricas::ahoraNs()) {}
+
+    /**
+     * @brief Exporta si transcurrió el intervalo configurado
+     * @param extra Función que recibe el flujo para añadir series propias
+     * @return true si se escribió el archivo
+     */
+    template <typename Funcion>
+    bool exportarSiCorresponde(uint64_t ahora, Funcion extra) {
+        if (ahora - ultimoNs < intervaloNs) {
+            return false;
+        }
+        ultimoNs = ahora;
+        return exportar(extra);
+    }
+
+    /**
+     * @brief Exporta de inmediato al archivo configurado
+     */
+    template <typename Funcion>
+    bool exportar(Funcion extra) {
+        std::string temporal = ruta + ".tmp";
+        {
+            std::ofstream archivo(temporal.c_str());
+            if (!archivo) {
+                std::cerr << "Error: No se pudo escribir " << temporal << std::endl;
+                return false;
+            }
+            Metricas::exportarPrometheus(archivo, Metricas::instantanea());
+            extra(archivo);
+        }
+        return std::rename(temporal.c_str(), ruta.c_str()) == 0;
+    }
+
+    const std::string& getRuta() const {
+        return ruta;
+    }
+};
+
+#endif // METRICAS_H
@@ -0,0 +1,527 @@
+/**
+ * @file MotorReglas.h
+ * @brief Reglas de alerta por sensor evaluadas en cada lectura
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Las reglas se leen de un archivo de texto y se compilan, por cada ID
+ * internado, en un bloque compacto con su estado incremental. Evaluar una
+ * lectura es O(1): un acceso al arreglo por ID y unas pocas comparaciones.
+ *
+ * Formato del archivo (una regla por línea, '#' inicia un comentario):
+ * @verbatim
+ * # PATRÓN  REGLA        PARÁMETROS
+ * T-*       umbral       -10 45             # fuera de [-10, 45] °C
+ * T-*       cambio       5                  # |actual - anterior| > 5
+ * P-*       ventana      3 10 95000 105000  # 3 de las últimas 10 fuera de [95000, 105000] Pa
+ * *         inactividad  30                 # 30 s sin lecturas
+ * @endverbatim
+ * El patrón es un ID exacto ("T-001"), un prefijo terminado en '*'
+ * ("T-*") o '*' para todos. Si varias reglas del mismo tipo coinciden
+ * con un sensor, prevalece la última del archivo.
+ */
+
+#ifndef MOTORREGLAS_H
+#define MOTORREGLAS_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "Metricas.h"
+#include "TablaSimbolos.h"
+
+/**
+ * @enum TipoRegla
+ * @brief Clases de regla soportadas (también es el bit en las máscaras)
+ */
+enum class TipoRegla : uint8_t {
+    Umbral = 0,    ///< Valor fuera de [mínimo, máximo]
+    Cambio,        ///< Diferencia con la lectura anterior mayor al máximo
+    Ventana,       ///< N de las últimas M lecturas fuera de rango
+    Inactividad,   ///< Sin lecturas durante más de X segundos
+    NUM_TIPOS
+};
+
+/**
+ * @struct Alerta
+ * @brief Alerta emitida por el motor
+ */
+struct Alerta {
+    uint32_t sensor;      ///< ID internado
+    TipoRegla tipo;       ///< Regla que la disparó
+    float valor;          ///< Lectura que la disparó (0 en inactividad)
+    uint64_t marcaNs;     ///< Metricas::ahoraNs() al emitirse
+};
+
+/**
+ * @class MotorReglas
+ * @brief Compila y evalúa reglas de alerta por sensor
+ *
+ * @details
+ * - Umbral, ventana e inactividad se disparan por flanco: una alerta al
+ *   entrar en violación y ninguna más hasta que la condición se normaliza.
+ *   Cambio se dispara en cada salto que supera el máximo.
+ * - La ventana N de M (M <= 64) guarda las últimas M violaciones en una
+ *   máscara de bits y su cantidad de unos; al desplazarla se resta el bit
+ *   que sale y se suma el que entra, sin recorrer la ventana.
+ * - Cada sensor se compila la primera vez que llega una lectura suya;
+ *   recargar el archivo invalida todo lo compilado.
+ * - Inactividad se verifica con revisarInactividad(), que el lector del
+ *   puerto llama como tarea periódica (SerialPort::setTareaPeriodica), de
+ *   modo que también corre cuando no llega ninguna línea.
+ *
+ * @note No es seguro entre hilos: se usa desde el hilo de ingesta.
+ *
+ * Ejemplo de uso:
+ * @code
+ * MotorReglas::global().cargar("reglas.conf");
+ * MotorReglas::global().evaluar(sensor->getId(), 51.3f, puerto.getMarcaLlegada());
+ * @endcode
+ */
+class MotorReglas {
+public:
+    static const int MAX_VENTANA = 64;               ///< M máximo de una regla ventana
+    static const int NUM_RECIENTES = 64;             ///< Alertas conservadas para mostrar
+    static const uint64_t PERIODO_INACTIVIDAD_NS = 100000000ULL;  ///< 100 ms entre revisiones
+
+private:
+    // Regla tal como se leyó del archivo
+    struct ReglaConfig {
+        char patron[50];
+        bool prefijo;       // patron termina en '*'
+        TipoRegla tipo;
+        float a;            // mínimo / máximo cambio / mínimo de ventana / segundos
+        float b;            // máximo (umbral y ventana)
+        uint8_t n;
+        uint8_t m;
+    };
+
+    // Reglas compiladas y estado incremental de un sensor (56 bytes)
+    struct EstadoSensor {
+        uint8_t compilado;      // 0 = aún no se aplicaron los patrones
+        uint8_t reglas;         // bit por TipoRegla activa
+        uint8_t disparadas;     // bit por alerta activa (flanco)
+        uint8_t tieneAnterior;
+        uint8_t ventanaN;
+        uint8_t ventanaM;
+        uint8_t fueraVentana;   // unos en la máscara
+        float umbralMin, umbralMax;
+        float cambioMax;
+        float ventanaMin, ventanaMax;
+        float anterior;
+        uint64_t mascara;       // bit 0 = última lectura
+        uint64_t ultimaNs;
+        uint64_t inactividadNs;
+    };
+
+    ReglaConfig* reglas;
+    int numReglas;
+    int numReglasPausadas;      // numReglas guardado por pausar()
+    EstadoSensor* estados;
+    uint32_t capacidadEstados;
+    Alerta recientes[NUM_RECIENTES];
+    uint64_t numAlertas;
+    uint64_t proximaRevisionNs;
+    bool eco;
+
+public:
+    MotorReglas()
+        : reglas(nullptr), numReglas(0), numReglasPausadas(0), estados(nullptr), capacidadEstados(0),
+          numAlertas(0), proximaRevisionNs(0), eco(true) {}
+
+    ~MotorReglas() {
+        delete[] reglas;
+        delete[] estados;
+    }
+
+    MotorReglas(const MotorReglas&) = delete;
+    MotorReglas& operator=(const MotorReglas&) = delete;
+
+    /**
+     * @brief Motor compartido por la ruta de ingesta
+     */
+    static MotorReglas& global() {
+        static MotorReglas motor;
+        return motor;
+    }
+
+    /**
+     * @brief Carga las reglas de @p ruta, reemplazando las actuales
+     * @return false si el archivo no existe o tiene errores (se conservan
+     *         las reglas anteriores)
+     */
+    bool cargar(const char* ruta) {
+        std::ifstream archivo(ruta);
+        if (!archivo) {
+            std::cerr << "Error: No se pudo abrir " << ruta << std::endl;
+            return false;
+        }
+        return cargar(archivo, ruta);
+    }
+
+    /**
+     * @brief Carga reglas desde un flujo con el formato del archivo
+     * @param entrada Flujo de texto
+     * @param origen Nombre usado en los mensajes de error
+     */
+    bool cargar(std::istream& entrada, const char* origen) {
+        int capacidad = 16;
+        int cantidad = 0;
+        ReglaConfig* nuevas = new ReglaConfig[capacidad];
+        std::string linea;
+        int numeroLinea = 0;
+        while (std::getline(entrada, linea)) {
+            numeroLinea++;
+            size_t comentario = linea.find('#');
+            if (comentario != std::string::npos) {
+                linea.erase(comentario);
+            }
+            std::istringstream campos(linea);
+            std::string patron;
+            if (!(campos >> patron)) {
+                continue;
+            }
+            if (cantidad == capacidad) {
+                ReglaConfig* mayor = new ReglaConfig[capacidad * 2];
+                std::memcpy(mayor, nuevas, sizeof(ReglaConfig) * cantidad);
+                delete[] nuevas;
+                nuevas = mayor;
+                capacidad *= 2;
+            }
+            if (!interpretarRegla(patron, campos, nuevas[cantidad])) {
+                std::cerr << "Error: " << origen << ":" << numeroLinea
+                          << ": regla inválida: " << linea << std::endl;
+                delete[] nuevas;
+                return false;
+            }
+            cantidad++;
+        }
+
+        delete[] reglas;
+        reglas = nuevas;
+        numReglas = cantidad;
+        numReglasPausadas = 0;
+        for (uint32_t i = 0; i < capacidadEstados; i++) {
+            estados[i].compilado = 0;
+        }
+        std::cout << "✓ " << cantidad << " reglas de alerta cargadas desde " << origen << std::endl;
+        return true;
+    }
+
+    /**
+     * @brief Elimina todas las reglas (evaluar() vuelve a no hacer nada)
+     */
+    void desactivar() {
+        numReglas = 0;
+        numReglasPausadas = 0;
+        for (uint32_t i = 0; i < capacidadEstados; i++) {
+            estados[i].compilado = 0;
+        }
+    }
+
+    /**
+     * @brief Suspende la evaluación conservando las reglas y el estado de cada sensor
+     * @details Para corridas sintéticas (prueba de carga) que no deben
+     *          disparar alertas ni tocar las ventanas de los sensores
+     *          reales. reanudar() vuelve a evaluar con las mismas reglas.
+     */
+    void pausar() {
+        if (numReglas > 0) {
+            numReglasPausadas = numReglas;
+            numReglas = 0;
+        }
+    }
+
+    void reanudar() {
+        if (numReglasPausadas > 0) {
+            numReglas = numReglasPausadas;
+            numReglasPausadas = 0;
+        }
+    }
+
+    /**
+     * @brief Descarta el estado de un sensor que dejó de existir
+     * @param sensor ID internado
+     * @details Sin esto revisarInactividad() seguiría alertando por él.
+     *          Si el ID vuelve a aparecer, sus reglas se compilan de nuevo.
+     */
+    void olvidar(uint32_t sensor) {
+        if (sensor < capacidadEstados) {
+            std::memset(&estados[sensor], 0, sizeof(EstadoSensor));
+        }
+    }
+
+    bool estaActivo() const {
+        return numReglas > 0;
+    }
+
+    int getNumReglas() const {
+        return numReglas;
+    }
+
+    /**
+     * @brief Activa o desactiva la impresión de cada alerta en std::cout
+     */
+    void setEco(bool activo) {
+        eco = activo;
+    }
+
+    /**
+     * @brief Evalúa una lectura contra las reglas de su sensor
+     * @param sensor ID internado
+     * @param valor Lectura ya convertida a float
+     * @param llegadaNs Metricas::ahoraNs() en que la lectura llegó al puerto
+     *                  (0 = sin marca; la latencia se mide desde aquí)
+     * @details Histograma::LatenciaAlerta observa desde @p llegadaNs hasta
+     *          la emisión, es decir, la ruta completa de ingesta a alerta.
+     */
+    void evaluar(uint32_t sensor, float valor, uint64_t llegadaNs = 0) {
+        if (numReglas == 0) {
+            return;
+        }
+        EstadoSensor& e = estado(sensor);
+        if (e.reglas == 0) {
+            return;
+        }
+        uint64_t ahora = Metricas::ahoraNs();
+        e.ultimaNs = ahora;
+        uint64_t inicio = llegadaNs != 0 ? llegadaNs : ahora;
+
+        if (e.reglas & bit(TipoRegla::Inactividad)) {
+            e.disparadas &= static_cast<uint8_t>(~bit(TipoRegla::Inactividad));
+        }
+        if (e.reglas & bit(TipoRegla::Umbral)) {
+            bool fuera = valor < e.umbralMin || valor > e.umbralMax;
+            porFlanco(e, sensor, TipoRegla::Umbral, fuera, valor, inicio);
+        }
+        if (e.reglas & bit(TipoRegla::Cambio)) {
+            float delta = valor - e.anterior;
+            if (e.tieneAnterior && (delta > e.cambioMax || -delta > e.cambioMax)) {
+                emitir(sensor, TipoRegla::Cambio, valor, inicio);
+            }
+            e.anterior = valor;
+            e.tieneAnterior = 1;
+        }
+        if (e.reglas & bit(TipoRegla::Ventana)) {
+            uint64_t entra = (valor < e.ventanaMin || valor > e.ventanaMax) ? 1 : 0;
+            uint64_t sale = (e.mascara >> (e.ventanaM - 1)) & 1;
+            uint64_t mascaraM = e.ventanaM == MAX_VENTANA ? ~0ULL : (1ULL << e.ventanaM) - 1;
+            e.mascara = ((e.mascara << 1) | entra) & mascaraM;
+            e.fueraVentana = static_cast<uint8_t>(e.fueraVentana + entra - sale);
+            porFlanco(e, sensor, TipoRegla::Ventana, e.fueraVentana >= e.ventanaN, valor, inicio);
+        }
+    }
+
+    /**
+     * @brief Emite alertas de inactividad para los sensores atrasados
+     * @param ahora Metricas::ahoraNs() actual
+     * @details Recorre los sensores sólo cada PERIODO_INACTIVIDAD_NS; el
+     *          resto de las llamadas cuesta una comparación. La latencia de
+     *          estas alertas se mide desde que venció el plazo del sensor.
+     */
+    void revisarInactividad(uint64_t ahora) {
+        if (numReglas == 0 || ahora < proximaRevisionNs) {
+            return;
+        }
+        proximaRevisionNs = ahora + PERIODO_INACTIVIDAD_NS;
+        for (uint32_t i = 0; i < capacidadEstados; i++) {
+            EstadoSensor& e = estados[i];
+            if (!e.compilado || !(e.reglas & bit(TipoRegla::Inactividad)) || e.ultimaNs == 0) {
+                continue;
+            }
+            porFlanco(e, i, TipoRegla::Inactividad, ahora - e.ultimaNs > e.inactividadNs, 0.0f,
+                      e.ultimaNs + e.inactividadNs);
+        }
+    }
+
+    /**
+     * @brief Total de alertas emitidas desde el inicio
+     */
+    uint64_t getNumAlertas() const {
+        return numAlertas;
+    }
+
+    /**
+     * @brief Imprime las últimas alertas (más reciente primero)
+     */
+    void imprimirRecientes(int maximo = 20) const {
+        std::cout << "\n=== Últimas Alertas (" << numAlertas << " en total) ===" << std::endl;
+        uint64_t disponibles = numAlertas < NUM_RECIENTES ? numAlertas : NUM_RECIENTES;
+        if (static_cast<uint64_t>(maximo) < disponibles) {
+            disponibles = static_cast<uint64_t>(maximo);
+        }
+        for (uint64_t k = 0; k < disponibles; k++) {
+            const Alerta& a = recientes[(numAlertas - 1 - k) % NUM_RECIENTES];
+            imprimirAlerta(a);
+        }
+        std::cout << "==============================\n" << std::endl;
+    }
+
+    /**
+     * @brief Nombre de la regla en el archivo de configuración
+     */
+    static const char* nombreTipo(TipoRegla tipo) {
+        switch (tipo) {
+            case TipoRegla::Umbral:      return "umbral";
+            case TipoRegla::Cambio:      return "cambio";
+            case TipoRegla::Ventana:     return "ventana";
+            case TipoRegla::Inactividad: return "inactividad";
+            default:                     return "?";
+        }
+    }
+
+private:
+    static uint8_t bit(TipoRegla tipo) {
+        return static_cast<uint8_t>(1u << static_cast<int>(tipo));
+    }
+
+    static bool interpretarRegla(const std::string& patron, std::istringstream& campos,
+                                 ReglaConfig& regla) {
+        if (patron.size() > TablaSimbolos::LARGO_MAXIMO) {
+            return false;
+        }
+        std::memset(&regla, 0, sizeof(regla));
+        regla.prefijo = patron[patron.size() - 1] == '*';
+        std::memcpy(regla.patron, patron.c_str(), patron.size() - (regla.prefijo ? 1 : 0));
+
+        std::string tipo;
+        if (!(campos >> tipo)) {
+            return false;
+        }
+        if (tipo == "umbral") {
+            regla.tipo = TipoRegla::Umbral;
+            if (!(campos >> regla.a >> regla.b) || regla.a > regla.b) return false;
+        } else if (tipo == "cambio") {
+            regla.tipo = TipoRegla::Cambio;
+            if (!(campos >> regla.a) || regla.a < 0) return false;
+        } else if (tipo == "ventana") {
+            regla.tipo = TipoRegla::Ventana;
+            int n, m;
+            if (!(campos >> n >> m >> regla.a >> regla.b) || regla.a > regla.b) return false;
+            if (m < 1 || m > MAX_VENTANA || n < 1 || n > m) return false;
+            regla.n = static_cast<uint8_t>(n);
+            regla.m = static_cast<uint8_t>(m);
+        } else if (tipo == "inactividad") {
+            regla.tipo = TipoRegla::Inactividad;
+            if (!(campos >> regla.a) || regla.a <= 0) return false;
+        } else {
+            return false;
+        }
+        std::string sobrante;
+        return !(campos >> sobrante);
+    }
+
+    bool coincide(const ReglaConfig& regla, const char* nombre) const {
+        if (regla.prefijo) {
+            return std::strncmp(nombre, regla.patron, std::strlen(regla.patron)) == 0;
+        }
+        return std::strcmp(nombre, regla.patron) == 0;
+    }
+
+    // Estado del sensor, compilando sus reglas la primera vez
+    EstadoSensor& estado(uint32_t sensor) {
+        if (sensor >= capacidadEstados) {
+            crecerEstados(sensor);
+        }
+        EstadoSensor& e = estados[sensor];
+        if (!e.compilado) {
+            compilar(sensor, e);
+        }
+        return e;
+    }
+
+    void compilar(uint32_t sensor, EstadoSensor& e) {
+        std::memset(&e, 0, sizeof(e));
+        e.compilado = 1;
+        const char* nombre = TablaSimbolos::global().nombre(sensor);
+        for (int i = 0; i < numReglas; i++) {
+            const ReglaConfig& r = reglas[i];
+            if (!coincide(r, nombre)) {
+                continue;
+            }
+            e.reglas |= bit(r.tipo);
+            switch (r.tipo) {
+                case TipoRegla::Umbral:
+                    e.umbralMin = r.a;
+                    e.umbralMax = r.b;
+                    break;
+                case TipoRegla::Cambio:
+                    e.cambioMax = r.a;
+                    break;
+                case TipoRegla::Ventana:
+                    e.ventanaN = r.n;
+                    e.ventanaM = r.m;
+                    e.ventanaMin = r.a;
+                    e.ventanaMax = r.b;
+                    e.mascara = 0;
+                    e.fueraVentana = 0;
+                    break;
+                case TipoRegla::Inactividad:
+                    e.inactividadNs = static_cast<uint64_t>(r.a * 1e9);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    void crecerEstados(uint32_t sensor) {
+        uint32_t nueva = capacidadEstados == 0 ? 64 : capacidadEstados;
+        while (nueva <= sensor) {
+            nueva *= 2;
+        }
+        EstadoSensor* mayor = new EstadoSensor[nueva];
+        if (capacidadEstados > 0) {
+            std::memcpy(mayor, estados, sizeof(EstadoSensor) * capacidadEstados);
+        }
+        std::memset(mayor + capacidadEstados, 0, sizeof(EstadoSensor) * (nueva - capacidadEstados));
+        delete[] estados;
+        estados = mayor;
+        capacidadEstados = nueva;
+    }
+
+    void porFlanco(EstadoSensor& e, uint32_t sensor, TipoRegla tipo, bool violada,
+                   float valor, uint64_t inicioNs) {
+        uint8_t b = bit(tipo);
+        if (violada && !(e.disparadas & b)) {
+            e.disparadas |= b;
+            emitir(sensor, tipo, valor, inicioNs);
+        } else if (!violada) {
+            e.disparadas &= static_cast<uint8_t>(~b);
+        }
+    }
+
+    void emitir(uint32_t sensor, TipoRegla tipo, float valor, uint64_t inicioNs) {
+        static const Contador contadores[] = {
+            Contador::AlertasUmbral, Contador::AlertasCambio,
+            Contador::AlertasVentana, Contador::AlertasInactividad
+        };
+        Alerta& a = recientes[numAlertas % NUM_RECIENTES];
+        a.sensor = sensor;
+        a.tipo = tipo;
+        a.valor = valor;
+        a.marcaNs = Metricas::ahoraNs();
+        numAlertas++;
+        Metricas::incrementar(contadores[static_cast<int>(tipo)]);
+        Metricas::observar(Histograma::LatenciaAlerta, a.marcaNs - inicioNs);
+        if (eco) {
+            std::cout << "🚨 ";
+            imprimirAlerta(a);
+        }
+    }
+
+    static void imprimirAlerta(const Alerta& a) {
+        std::cout << "ALERTA [" << nombreTipo(a.tipo) << "] "
+                  << TablaSimbolos::global().nombre(a.sensor);
+        if (a.tipo != TipoRegla::Inactividad) {
+            std::cout << " = " << a.valor;
+        }
+        std::cout << std::endl;
+    }
+};
+
+#endif // MOTORREGLAS_H
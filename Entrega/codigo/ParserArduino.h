@@ -0,0 +1,149 @@
+/**
+ * @file ParserArduino.h
+ * @brief Parser sin asignaciones de las líneas de texto del Arduino
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Interpreta "T ID VALOR" / "P ID VALOR" directamente sobre un rango de
+ * caracteres, sin construir std::string ni std::istringstream. Es una
+ * función pura, por lo que varios hilos pueden parsear partes distintas
+ * de un mismo archivo al mismo tiempo.
+ */
+
+#ifndef PARSERARDUINO_H
+#define PARSERARDUINO_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "TablaSimbolos.h"
+
+/**
+ * @enum ResultadoParseo
+ * @brief Resultado de interpretar una línea
+ */
+enum class ResultadoParseo {
+    Valida,             ///< Lectura T, P o V completa
+    Ignorada,           ///< Línea vacía o de log del Arduino
+    SinFormato,         ///< Sólo un número, sin "TIPO ID"
+    FormatoInvalido,    ///< No se pudo interpretar
+    ValorTemperatura,   ///< Tipo T con valor no numérico
+    ValorPresion,       ///< Tipo P con valor no numérico
+    ValorVibracion,     ///< Tipo V con valor no numérico
+    TipoDesconocido     ///< Tipo distinto de T/P/V
+};
+
+/**
+ * @struct LecturaArduino
+ * @brief Línea ya interpretada, lista para registrarse en un sensor
+ */
+struct LecturaArduino {
+    ResultadoParseo resultado;  ///< Clasificación de la línea
+    char tipo;                  ///< 'T', 'P' o 'V' (normalizado a mayúscula si es válido)
+    char id[50];                ///< Identificador del sensor (máx. 49 caracteres)
+    float temperatura;          ///< Valor si tipo == 'T'
+    int presion;                ///< Valor si tipo == 'P'
+    double vibracion;           ///< Valor si tipo == 'V'
+    double numeroSinFormato;    ///< Valor si resultado == SinFormato
+    bool tienePunto;            ///< La línea contenía '.' (sólo diagnóstico)
+    uint32_t simbolo;           ///< ID internado de @c id, o TablaSimbolos::SIN_ID si aún no se internó
+};
+
+/**
+ * @brief Indica si [ini, fin) contiene la subcadena @p patron
+ */
+inline bool contieneTexto(const char* ini, const char* fin, const char* patron) {
+    size_t largo = std::strlen(patron);
+    for (const char* p = ini; p + largo <= fin; p++) {
+        if (std::memcmp(p, patron, largo) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Interpreta una línea del Arduino
+ * @param ini Primer carácter de la línea
+ * @param fin Uno después del último carácter (sin '\\n')
+ * @param out Lectura resultante
+ *
+ * @details
+ * Replica las reglas de extracción de flujo del lector original:
+ * el tipo es el primer carácter no blanco, el ID es el siguiente token
+ * y el valor se lee como float (T) o int (P) ignorando el texto que le
+ * siga ("101.7" como presión se registra como 101).
+ */
+inline void parsearLineaArduino(const char* ini, const char* fin, LecturaArduino& out) {
+    out.tipo = 0;
+    out.id[0] = '\0';
+    out.simbolo = TablaSimbolos::SIN_ID;
+    out.tienePunto = false;
+
+    // Ignorar líneas de log del Arduino
+    if (ini == fin ||
+        contieneTexto(ini, fin, "===") ||
+        contieneTexto(ini, fin, "Arduino") ||
+        contieneTexto(ini, fin, "Formato")) {
+        out.resultado = ResultadoParseo::Ignorada;
+        return;
+    }
+
+    // Copia terminada en '\0' para strtof/strtol (las líneas son cortas)
+    char linea[128];
+    size_t largo = static_cast<size_t>(fin - ini);
+    if (largo >= sizeof(linea)) {
+        largo = sizeof(linea) - 1;
+    }
+    std::memcpy(linea, ini, largo);
+    linea[largo] = '\0';
+    out.tienePunto = std::memchr(linea, '.', largo) != nullptr;
+
+    const char* p = linea;
+    while (*p == ' ' || *p == '\t') p++;
+    char tipo = *p;
+    if (tipo != '\0') p++;
+    while (*p == ' ' || *p == '\t') p++;
+    const char* inicioId = p;
+    while (*p != '\0' && *p != ' ' && *p != '\t') p++;
+
+    if (tipo == '\0' || p == inicioId) {
+        // Si no tiene formato completo, intentar leer solo el número
+        char* finNumero;
+        out.numeroSinFormato = std::strtod(linea, &finNumero);
+        out.resultado = (finNumero != linea) ? ResultadoParseo::SinFormato
+                                             : ResultadoParseo::FormatoInvalido;
+        return;
+    }
+
+    size_t largoId = static_cast<size_t>(p - inicioId);
+    if (largoId > sizeof(out.id) - 1) {
+        largoId = sizeof(out.id) - 1;
+    }
+    std::memcpy(out.id, inicioId, largoId);
+    out.id[largoId] = '\0';
+    out.tipo = tipo;
+
+    char* finValor;
+    if (tipo == 'T' || tipo == 't') {
+        out.tipo = 'T';
+        out.temperatura = std::strtof(p, &finValor);
+        out.resultado = (finValor != p) ? ResultadoParseo::Valida
+                                        : ResultadoParseo::ValorTemperatura;
+    } else if (tipo == 'P' || tipo == 'p') {
+        out.tipo = 'P';
+        out.presion = static_cast<int>(std::strtol(p, &finValor, 10));
+        out.resultado = (finValor != p) ? ResultadoParseo::Valida
+                                        : ResultadoParseo::ValorPresion;
+    } else if (tipo == 'V' || tipo == 'v') {
+        out.tipo = 'V';
+        out.vibracion = std::strtod(p, &finValor);
+        out.resultado = (finValor != p) ? ResultadoParseo::Valida
+                                        : ResultadoParseo::ValorVibracion;
+    } else {
+        out.resultado = ResultadoParseo::TipoDesconocido;
+    }
+}
+
+#endif // PARSERARDUINO_H
@@ -0,0 +1,118 @@
+/**
+ * @file PoliticasSensor.h
+ * @brief Políticas de procesamiento elegidas en tiempo de compilación
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Cada política define un @c Acumulador<T> que recibe las lecturas una a
+ * una y un texto para el resultado. SensorTipado instancia el acumulador
+ * con el tipo de sus lecturas, así que agregar() se expande en línea
+ * dentro del recorrido del historial sin llamadas virtuales.
+ */
+
+#ifndef POLITICASSENSOR_H
+#define POLITICASSENSOR_H
+
+#include <cmath>
+
+/**
+ * @struct PoliticaMinimo
+ * @brief Lectura más baja del historial
+ */
+struct PoliticaMinimo {
+    static const char* descripcion() { return "Lectura minima calculada"; }
+    static const int DECIMALES = 1;
+
+    template <typename T>
+    struct Acumulador {
+        T minimo;
+        bool hay;
+
+        Acumulador() : minimo(T()), hay(false) {}
+
+        void agregar(T valor) {
+            if (!hay || valor < minimo) {
+                minimo = valor;
+                hay = true;
+            }
+        }
+
+        double resultado() const { return static_cast<double>(minimo); }
+    };
+};
+
+/**
+ * @struct PoliticaPromedio
+ * @brief Media aritmética del historial (suma en double, sin desborde)
+ */
+struct PoliticaPromedio {
+    static const char* descripcion() { return "Promedio calculado"; }
+    static const int DECIMALES = 2;
+
+    template <typename T>
+    struct Acumulador {
+        double suma;
+        long long cuenta;
+
+        Acumulador() : suma(0.0), cuenta(0) {}
+
+        void agregar(T valor) {
+            suma += valor;
+            cuenta++;
+        }
+
+        double resultado() const { return cuenta > 0 ? suma / cuenta : 0.0; }
+    };
+};
+
+/**
+ * @struct PoliticaRMS
+ * @brief Raíz del valor cuadrático medio (energía de una vibración)
+ */
+struct PoliticaRMS {
+    static const char* descripcion() { return "RMS calculado"; }
+    static const int DECIMALES = 3;
+
+    template <typename T>
+    struct Acumulador {
+        double sumaCuadrados;
+        long long cuenta;
+
+        Acumulador() : sumaCuadrados(0.0), cuenta(0) {}
+
+        void agregar(T valor) {
+            double v = static_cast<double>(valor);
+            sumaCuadrados += v * v;
+            cuenta++;
+        }
+
+        double resultado() const { return cuenta > 0 ? std::sqrt(sumaCuadrados / cuenta) : 0.0; }
+    };
+};
+
+/**
+ * @struct PoliticaConteoPicos
+ * @brief Cantidad de lecturas por encima de @p Umbral
+ * @tparam Umbral Límite entero en las unidades del sensor
+ */
+template <int Umbral>
+struct PoliticaConteoPicos {
+    static const char* descripcion() { return "Picos contados"; }
+    static const int DECIMALES = 0;
+
+    template <typename T>
+    struct Acumulador {
+        long long picos;
+
+        Acumulador() : picos(0) {}
+
+        void agregar(T valor) {
+            picos += valor > static_cast<T>(Umbral) ? 1 : 0;
+        }
+
+        double resultado() const { return static_cast<double>(picos); }
+    };
+};
+
+#endif // POLITICASSENSOR_H
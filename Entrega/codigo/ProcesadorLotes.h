@@ -0,0 +1,362 @@
+/**
+ * @file ProcesadorLotes.h
+ * @brief Ingesta no interactiva de registros seriales desde archivos o stdin
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Reproduce capturas del puerto serial a máxima velocidad. Los archivos
+ * se proyectan en memoria con mmap() y se recorren por ventanas; cada
+ * ventana se corta en fronteras de línea, se parsea en paralelo y luego
+ * se registra en orden en la lista de gestión.
+ */
+
+#ifndef PROCESADORLOTES_H
+#define PROCESADORLOTES_H
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "IngestaArduino.h"
+#include "ParserArduino.h"
+
+/**
+ * @struct ResumenLote
+ * @brief Totales acumulados de una corrida por lotes
+ */
+struct ResumenLote {
+    static const int NUM_RESULTADOS = static_cast<int>(ResultadoParseo::TipoDesconocido) + 1;
+
+    int fuentes;                                 ///< Archivos (o stdin) procesados
+    unsigned long long bytes;                    ///< Bytes recorridos
+    unsigned long long lineas;                   ///< Líneas no vacías
+    unsigned long long porResultado[NUM_RESULTADOS];  ///< Conteo por ResultadoParseo
+    double segundos;                             ///< Tiempo total de ingesta
+
+    ResumenLote() : fuentes(0), bytes(0), lineas(0), segundos(0.0) {
+        for (int i = 0; i < NUM_RESULTADOS; i++) porResultado[i] = 0;
+    }
+
+    unsigned long long cantidad(ResultadoParseo r) const {
+        return porResultado[static_cast<int>(r)];
+    }
+
+    void imprimir(int numSensores) const {
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        double mb = bytes / (1024.0 * 1024.0);
+        std::cout << "\n=== Resumen de Ingesta por Lotes ===" << std::endl;
+        std::cout << "Fuentes procesadas:   " << fuentes << std::endl;
+        std::cout << "Bytes leídos:         " << bytes << std::endl;
+        std::cout << "Líneas:               " << lineas << std::endl;
+        std::cout << "Lecturas válidas:     " << cantidad(ResultadoParseo::Valida) << std::endl;
+        std::cout << "Líneas de log:        " << cantidad(ResultadoParseo::Ignorada) << std::endl;
+        std::cout << "Errores de parseo:" << std::endl;
+        std::cout << "  sin formato:        " << cantidad(ResultadoParseo::SinFormato) << std::endl;
+        std::cout << "  formato inválido:   " << cantidad(ResultadoParseo::FormatoInvalido) << std::endl;
+        std::cout << "  valor temperatura:  " << cantidad(ResultadoParseo::ValorTemperatura) << std::endl;
+        std::cout << "  valor presión:      " << cantidad(ResultadoParseo::ValorPresion) << std::endl;
+        std::cout << "  valor vibración:    " << cantidad(ResultadoParseo::ValorVibracion) << std::endl;
+        std::cout << "  tipo desconocido:   " << cantidad(ResultadoParseo::TipoDesconocido) << std::endl;
+        std::cout << "Sensores:             " << numSensores << std::endl;
+        std::cout << "Tiempo:               " << std::fixed << std::setprecision(3)
+                  << segundos << " s" << std::endl;
+        if (segundos > 0.0) {
+            std::cout << "Rendimiento:          " << std::setprecision(0)
+                      << cantidad(ResultadoParseo::Valida) / segundos << " lecturas/s, "
+                      << std::setprecision(1) << mb / segundos << " MB/s" << std::endl;
+        }
+        std::cout << "====================================\n" << std::endl;
+        std::cout.flags(formato);
+        std::cout.precision(precision);
+    }
+};
+
+/**
+ * @struct TramoLote
+ * @brief Porción de una ventana asignada a un hilo de parseo
+ */
+struct TramoLote {
+    const char* ini;
+    const char* fin;
+    LecturaArduino* lecturas;   ///< Lecturas válidas, en orden de aparición
+    size_t cantidad;
+    size_t capacidad;
+    unsigned long long lineas;
+    unsigned long long porResultado[ResumenLote::NUM_RESULTADOS];
+
+    TramoLote() : ini(nullptr), fin(nullptr), lecturas(nullptr), cantidad(0), capacidad(0), lineas(0) {
+        for (int i = 0; i < ResumenLote::NUM_RESULTADOS; i++) porResultado[i] = 0;
+    }
+
+    ~TramoLote() {
+        delete[] lecturas;
+    }
+
+    TramoLote(const TramoLote&) = delete;
+    TramoLote& operator=(const TramoLote&) = delete;
+
+    void agregar(const LecturaArduino& lectura) {
+        if (cantidad == capacidad) {
+            size_t nueva = capacidad == 0 ? 1024 : capacidad * 2;
+            LecturaArduino* arreglo = new LecturaArduino[nueva];
+            if (cantidad > 0) {
+                std::memcpy(arreglo, lecturas, cantidad * sizeof(LecturaArduino));
+            }
+            delete[] lecturas;
+            lecturas = arreglo;
+            capacidad = nueva;
+        }
+        lecturas[cantidad++] = lectura;
+    }
+
+    // Parsea todas las líneas del tramo (se ejecuta en un hilo de trabajo)
+    void parsear() {
+        const char* p = ini;
+        LecturaArduino lectura;
+        while (p < fin) {
+            const char* finLinea = p;
+            while (finLinea < fin && *finLinea != '\n' && *finLinea != '\r') {
+                finLinea++;
+            }
+            if (finLinea > p) {
+                lineas++;
+                parsearLineaArduino(p, finLinea, lectura);
+                porResultado[static_cast<int>(lectura.resultado)]++;
+                if (lectura.resultado == ResultadoParseo::Valida) {
+                    agregar(lectura);
+                } else {
+                    contarErrorParseo(lectura.resultado);
+                }
+            }
+            p = finLinea + 1;
+        }
+    }
+};
+
+/**
+ * @class ProcesadorLotes
+ * @brief Ingesta paralela de registros de texto del Arduino
+ *
+ * @details
+ * El parseo es paralelo y sin estado compartido; el registro en la lista
+ * de gestión es secuencial y respeta el orden del archivo, de modo que
+ * el historial de cada sensor queda igual que si se hubiera leído del
+ * puerto serial.
+ *
+ * Ejemplo de uso:
+ * @code
+ * ProcesadorLotes lotes(4);
+ * lotes.procesarArchivo("captura.log", listaGestion);
+ * lotes.getResumen().imprimir(listaGestion->getTamanio());
+ * @endcode
+ */
+class ProcesadorLotes {
+public:
+    static const size_t TAMANIO_VENTANA = 16 * 1024 * 1024;   ///< Bytes por ventana
+    static const size_t MINIMO_POR_HILO = 64 * 1024;          ///< Evita hilos para ventanas pequeñas
+
+private:
+    int numHilos;
+    ResumenLote resumen;
+
+public:
+    /**
+     * @param hilos Hilos de parseo (0 = núcleos disponibles)
+     */
+    ProcesadorLotes(int hilos = 0) : numHilos(hilos) {
+        if (numHilos <= 0) {
+            numHilos = static_cast<int>(std::thread::hardware_concurrency());
+        }
+        if (numHilos <= 0) {
+            numHilos = 1;
+        }
+    }
+
+    /**
+     * @brief Ingresa un archivo proyectándolo en memoria
+     * @tparam Destino ListaGeneral o AlmacenColumnar (cualquier tipo con
+     *                 una sobrecarga registrarLectura(Destino*, const LecturaArduino&))
+     * @return false si el archivo no se pudo abrir o proyectar
+     */
+    template <typename Destino>
+    bool procesarArchivo(const std::string& ruta, Destino* lista) {
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "Error: No se pudo abrir " << ruta << std::endl;
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            std::cerr << "Error: No se pudo consultar " << ruta << std::endl;
+            close(fd);
+            return false;
+        }
+
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        size_t tamanio = static_cast<size_t>(info.st_size);
+        if (tamanio > 0) {
+            void* mapa = mmap(nullptr, tamanio, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapa == MAP_FAILED) {
+                std::cerr << "Error: No se pudo proyectar " << ruta << std::endl;
+                close(fd);
+                return false;
+            }
+            madvise(mapa, tamanio, MADV_SEQUENTIAL);
+
+            const char* datos = static_cast<const char*>(mapa);
+            const char* fin = datos + tamanio;
+            const char* p = datos;
+            while (p < fin) {
+                const char* corte = cortarVentana(p, fin);
+                procesarBloque(p, corte, lista);
+                p = corte;
+            }
+            munmap(mapa, tamanio);
+        }
+        close(fd);
+
+        resumen.fuentes++;
+        resumen.bytes += tamanio;
+        resumen.segundos += segundosDesde(inicio);
+        return true;
+    }
+
+    /**
+     * @brief Ingresa la entrada estándar hasta EOF
+     * @details Se lee por ventanas; la línea incompleta al final de cada
+     *          ventana se traslada al inicio de la siguiente.
+     */
+    template <typename Destino>
+    bool procesarEntradaEstandar(Destino* lista) {
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        char* buffer = new char[TAMANIO_VENTANA];
+        size_t pendiente = 0;
+        bool ok = true;
+
+        while (true) {
+            ssize_t n = read(STDIN_FILENO, buffer + pendiente, TAMANIO_VENTANA - pendiente);
+            if (n < 0) {
+                std::cerr << "Error al leer la entrada estándar" << std::endl;
+                ok = false;
+                break;
+            }
+            if (n == 0) {
+                procesarBloque(buffer, buffer + pendiente, lista);
+                break;
+            }
+            resumen.bytes += static_cast<unsigned long long>(n);
+            size_t usado = pendiente + static_cast<size_t>(n);
+
+            // Procesar hasta el último fin de línea; si la ventana está
+            // llena y no hay ninguno, se procesa completa
+            size_t corte = usado;
+            while (corte > 0 && buffer[corte - 1] != '\n' && buffer[corte - 1] != '\r') {
+                corte--;
+            }
+            if (corte == 0 && usado == TAMANIO_VENTANA) {
+                corte = usado;
+            }
+            procesarBloque(buffer, buffer + corte, lista);
+            pendiente = usado - corte;
+            std::memmove(buffer, buffer + corte, pendiente);
+        }
+
+        delete[] buffer;
+        resumen.fuentes++;
+        resumen.segundos += segundosDesde(inicio);
+        return ok;
+    }
+
+    const ResumenLote& getResumen() const {
+        return resumen;
+    }
+
+    int getNumHilos() const {
+        return numHilos;
+    }
+
+private:
+    static double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    // Avanza hasta justo después del siguiente fin de línea (o fin)
+    static const char* siguienteLinea(const char* p, const char* fin) {
+        while (p < fin && *p != '\n' && *p != '\r') {
+            p++;
+        }
+        return p < fin ? p + 1 : fin;
+    }
+
+    // Fin de la ventana que empieza en p, ajustado a frontera de línea
+    static const char* cortarVentana(const char* p, const char* fin) {
+        if (static_cast<size_t>(fin - p) <= TAMANIO_VENTANA) {
+            return fin;
+        }
+        return siguienteLinea(p + TAMANIO_VENTANA - 1, fin);
+    }
+
+    // Parsea [ini, fin) en paralelo y registra las lecturas en orden
+    template <typename Destino>
+    void procesarBloque(const char* ini, const char* fin, Destino* lista) {
+        if (ini >= fin) {
+            return;
+        }
+
+        size_t largo = static_cast<size_t>(fin - ini);
+        int partes = numHilos;
+        if (largo / MINIMO_POR_HILO < static_cast<size_t>(partes)) {
+            partes = static_cast<int>(largo / MINIMO_POR_HILO);
+        }
+        if (partes < 1) {
+            partes = 1;
+        }
+
+        TramoLote* tramos = new TramoLote[partes];
+        const char* p = ini;
+        for (int i = 0; i < partes; i++) {
+            tramos[i].ini = p;
+            tramos[i].fin = (i == partes - 1) ? fin
+                          : siguienteLinea(ini + largo * (i + 1) / partes, fin);
+            if (tramos[i].fin < p) {
+                tramos[i].fin = p;
+            }
+            p = tramos[i].fin;
+        }
+
+        if (partes == 1) {
+            tramos[0].parsear();
+        } else {
+            std::thread* hilos = new std::thread[partes - 1];
+            for (int i = 1; i < partes; i++) {
+                hilos[i - 1] = std::thread(&TramoLote::parsear, &tramos[i]);
+            }
+            tramos[0].parsear();
+            for (int i = 0; i < partes - 1; i++) {
+                hilos[i].join();
+            }
+            delete[] hilos;
+        }
+
+        for (int i = 0; i < partes; i++) {
+            for (size_t k = 0; k < tramos[i].cantidad; k++) {
+                registrarLectura(lista, tramos[i].lecturas[k]);
+            }
+            resumen.lineas += tramos[i].lineas;
+            for (int r = 0; r < ResumenLote::NUM_RESULTADOS; r++) {
+                resumen.porResultado[r] += tramos[i].porResultado[r];
+            }
+        }
+        delete[] tramos;
+    }
+};
+
+#endif // PROCESADORLOTES_H
@@ -0,0 +1,279 @@
+/**
+ * @file ProtocoloBinario.h
+ * @brief Protocolo serial binario con tramas de longitud fija y CRC-16
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Alternativa compacta al texto "T T-001 23.5". Cada lectura ocupa
+ * 10 bytes en lugar de 13-20 y se valida con CRC-16/CCITT-FALSE, de modo
+ * que los bytes corrompidos en el enlace se detectan y se descartan.
+ *
+ * Formato de la trama (enteros en little-endian):
+ * @verbatim
+ *  0      1..2         3      4..7         8..9
+ * +------+------------+------+------------+-----------+
+ * | 0xA5 | indice u16 | tipo | valor i32  | CRC-16    |
+ * +------+------------+------+------------+-----------+
+ * @endverbatim
+ * - @c indice: número del sensor (0 - 65535); T/7 equivale al ID de
+ *   texto "T-007"
+ * - @c tipo: 'T' (valor en centésimas de °C) o 'P' (valor en Pa)
+ * - @c CRC-16: polinomio 0x1021, valor inicial 0xFFFF, sobre los bytes 1..7
+ */
+
+#ifndef PROTOCOLOBINARIO_H
+#define PROTOCOLOBINARIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include "Metricas.h"
+#include "ParserArduino.h"
+
+/**
+ * @enum ModoProtocolo
+ * @brief Formato esperado en el puerto serial
+ */
+enum class ModoProtocolo {
+    Texto,       ///< Líneas "T ID VALOR" / "P ID VALOR"
+    Binario,     ///< Tramas de 10 bytes con CRC
+    Automatico   ///< Detectar a partir de los primeros bytes recibidos
+};
+
+/**
+ * @struct TramaBinaria
+ * @brief Contenido de una trama decodificada
+ */
+struct TramaBinaria {
+    uint16_t indice;  ///< Número de sensor
+    char tipo;        ///< 'T' o 'P'
+    int32_t valor;    ///< Centésimas de °C (T) o Pa (P)
+};
+
+/**
+ * @class ProtocoloBinario
+ * @brief Constantes, CRC y codificación de tramas
+ */
+class ProtocoloBinario {
+public:
+    static const uint8_t SINCRONIA = 0xA5;   ///< Primer byte de toda trama
+    static const int LONGITUD_TRAMA = 10;    ///< Bytes por trama
+    static const int MAX_SENSORES = 65536;   ///< Índices distintos por tipo
+
+    /**
+     * @brief Comando de texto que pide al Arduino cambiar a tramas binarias
+     */
+    static const char* comandoActivar() {
+        return "MODO BINARIO\n";
+    }
+
+    /**
+     * @brief CRC-16/CCITT-FALSE por tabla
+     */
+    static uint16_t crc16(const uint8_t* datos, size_t longitud) {
+        const uint16_t* tabla = tablaCrc();
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 0; i < longitud; i++) {
+            crc = static_cast<uint16_t>((crc << 8) ^ tabla[((crc >> 8) ^ datos[i]) & 0xFF]);
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Escribe una trama completa en @p destino (LONGITUD_TRAMA bytes)
+     */
+    static void codificar(const TramaBinaria& trama, uint8_t* destino) {
+        uint32_t v = static_cast<uint32_t>(trama.valor);
+        destino[0] = SINCRONIA;
+        destino[1] = static_cast<uint8_t>(trama.indice);
+        destino[2] = static_cast<uint8_t>(trama.indice >> 8);
+        destino[3] = static_cast<uint8_t>(trama.tipo);
+        destino[4] = static_cast<uint8_t>(v);
+        destino[5] = static_cast<uint8_t>(v >> 8);
+        destino[6] = static_cast<uint8_t>(v >> 16);
+        destino[7] = static_cast<uint8_t>(v >> 24);
+        uint16_t crc = crc16(destino + 1, 7);
+        destino[8] = static_cast<uint8_t>(crc);
+        destino[9] = static_cast<uint8_t>(crc >> 8);
+    }
+
+    /**
+     * @brief Valida y decodifica una trama que empieza en @p datos
+     * @return false si el byte de sincronía, el tipo o el CRC no coinciden
+     */
+    static bool decodificar(const uint8_t* datos, TramaBinaria& trama) {
+        if (datos[0] != SINCRONIA || (datos[3] != 'T' && datos[3] != 'P')) {
+            return false;
+        }
+        uint16_t crc = static_cast<uint16_t>(datos[8] | (datos[9] << 8));
+        if (crc16(datos + 1, 7) != crc) {
+            return false;
+        }
+        trama.indice = static_cast<uint16_t>(datos[1] | (datos[2] << 8));
+        trama.tipo = static_cast<char>(datos[3]);
+        trama.valor = static_cast<int32_t>(static_cast<uint32_t>(datos[4]) |
+                                           (static_cast<uint32_t>(datos[5]) << 8) |
+                                           (static_cast<uint32_t>(datos[6]) << 16) |
+                                           (static_cast<uint32_t>(datos[7]) << 24));
+        return true;
+    }
+
+    /**
+     * @brief Convierte una trama en la misma lectura que produciría el texto
+     */
+    static void aLectura(const TramaBinaria& trama, LecturaArduino& lectura) {
+        lectura.resultado = ResultadoParseo::Valida;
+        lectura.tipo = trama.tipo;
+        lectura.tienePunto = false;
+        lectura.simbolo = TablaSimbolos::SIN_ID;
+        std::snprintf(lectura.id, sizeof(lectura.id), "%c-%03u", trama.tipo,
+                      static_cast<unsigned>(trama.indice));
+        if (trama.tipo == 'T') {
+            lectura.temperatura = trama.valor / 100.0f;
+        } else {
+            lectura.presion = trama.valor;
+        }
+    }
+
+    /**
+     * @brief Decide el formato a partir de los primeros bytes recibidos
+     * @param datos Bytes recibidos
+     * @param longitud Cantidad de bytes
+     * @param modo Resultado de la detección
+     * @return false si aún no hay evidencia suficiente
+     *
+     * @details
+     * Sólo cuentan el marcador y el CRC: una trama válida es evidencia de
+     * binario (que el texto forme una por azar exige acertar el tipo y
+     * los 16 bits del CRC). Un flujo binario sin errores trae una trama
+     * completa en cualquier tramo de 2 x LONGITUD_TRAMA bytes, así que si
+     * no aparece ninguna en ese tramo y hay dos fines de línea, es texto.
+     * Los bytes fuera de ASCII (UTF-8, ruido del enlace) no deciden nada.
+     */
+    static bool detectar(const uint8_t* datos, size_t longitud, ModoProtocolo& modo) {
+        TramaBinaria trama;
+        for (size_t i = 0; i + LONGITUD_TRAMA <= longitud; i++) {
+            if (datos[i] == SINCRONIA && decodificar(datos + i, trama)) {
+                modo = ModoProtocolo::Binario;
+                return true;
+            }
+        }
+        if (longitud < 2 * static_cast<size_t>(LONGITUD_TRAMA)) {
+            return false;
+        }
+        int finesLinea = 0;
+        for (size_t i = 0; i < longitud; i++) {
+            if (datos[i] == '\n') {
+                finesLinea++;
+            }
+        }
+        if (finesLinea >= 2) {
+            modo = ModoProtocolo::Texto;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    struct TablaCrc {
+        uint16_t valores[256];
+
+        TablaCrc() {
+            for (int i = 0; i < 256; i++) {
+                uint16_t crc = static_cast<uint16_t>(i << 8);
+                for (int b = 0; b < 8; b++) {
+                    crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                                         : static_cast<uint16_t>(crc << 1);
+                }
+                valores[i] = crc;
+            }
+        }
+    };
+
+    // Inicialización única y segura entre hilos (static local de C++11)
+    static const uint16_t* tablaCrc() {
+        static const TablaCrc tabla;
+        return tabla.valores;
+    }
+};
+
+/**
+ * @class DecodificadorBinario
+ * @brief Decodificador incremental que se resincroniza tras un error
+ *
+ * @details
+ * Acumula bytes hasta completar una trama. Si el tipo o el CRC no son
+ * válidos, descarta sólo el byte de sincronía y vuelve a buscar 0xA5 en
+ * los bytes ya recibidos, por lo que una trama válida que empiece dentro
+ * de una trama corrupta no se pierde.
+ *
+ * Ejemplo de uso:
+ * @code
+ * DecodificadorBinario dec;
+ * dec.alimentar(bytes, n, [](const TramaBinaria& t) { ... });
+ * @endcode
+ */
+class DecodificadorBinario {
+private:
+    uint8_t pendiente[ProtocoloBinario::LONGITUD_TRAMA];
+    int usados;
+    unsigned long long tramasValidas;
+    unsigned long long tramasCorruptas;
+    unsigned long long bytesDescartados;
+
+public:
+    DecodificadorBinario()
+        : usados(0), tramasValidas(0), tramasCorruptas(0), bytesDescartados(0) {}
+
+    /**
+     * @brief Procesa @p n bytes e invoca @p f por cada trama válida
+     */
+    template <typename Funcion>
+    void alimentar(const uint8_t* datos, size_t n, Funcion f) {
+        for (size_t i = 0; i < n; i++) {
+            if (usados == 0 && datos[i] != ProtocoloBinario::SINCRONIA) {
+                bytesDescartados++;
+                Metricas::incrementar(Contador::BytesDescartados);
+                continue;
+            }
+            pendiente[usados++] = datos[i];
+            if (usados < ProtocoloBinario::LONGITUD_TRAMA) {
+                continue;
+            }
+
+            TramaBinaria trama;
+            if (ProtocoloBinario::decodificar(pendiente, trama)) {
+                tramasValidas++;
+                Metricas::incrementar(Contador::TramasBinarias);
+                usados = 0;
+                f(trama);
+            } else {
+                tramasCorruptas++;
+                Metricas::incrementar(Contador::TramasCorruptas);
+                resincronizar();
+            }
+        }
+    }
+
+    unsigned long long getTramasValidas() const { return tramasValidas; }
+    unsigned long long getTramasCorruptas() const { return tramasCorruptas; }
+    unsigned long long getBytesDescartados() const { return bytesDescartados; }
+
+private:
+    // Desplaza la ventana hasta el siguiente 0xA5 después del inicio actual
+    void resincronizar() {
+        int siguiente = 1;
+        while (siguiente < usados && pendiente[siguiente] != ProtocoloBinario::SINCRONIA) {
+            siguiente++;
+        }
+        bytesDescartados += static_cast<unsigned long long>(siguiente);
+        Metricas::incrementar(Contador::BytesDescartados, static_cast<uint64_t>(siguiente));
+        for (int i = siguiente; i < usados; i++) {
+            pendiente[i - siguiente] = pendiente[i];
+        }
+        usados -= siguiente;
+    }
+};
+
+#endif // PROTOCOLOBINARIO_H
@@ -0,0 +1,184 @@
+/**
+ * @file ReporteMemoria.h
+ * @brief Reporte de memoria de la flota, presupuestos y compactación
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Resume cuántos bytes ocupa cada tipo de sensor y cuántos cuesta cada
+ * lectura frente al tamaño del dato. En la lista de gestión cada lectura
+ * es un nodo reservado por separado, así que el costo real es varias
+ * veces el dato; compactarFlota() muestra cuánto se recupera al pasar
+ * los historiales a bloques contiguos.
+ */
+
+#ifndef REPORTEMEMORIA_H
+#define REPORTEMEMORIA_H
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include "ListaGeneral.h"
+#include "SensorBase.h"
+
+/**
+ * @class ReporteMemoria
+ * @brief Operaciones de memoria sobre toda la lista de gestión
+ *
+ * Ejemplo de uso:
+ * @code
+ * ReporteMemoria::fijarPresupuesto(listaGestion, 64 * 1024);
+ * ReporteMemoria::imprimir(listaGestion);
+ * size_t liberados = ReporteMemoria::compactarFlota(listaGestion);
+ * @endcode
+ */
+class ReporteMemoria {
+private:
+    static const int MAX_TIPOS = 8;
+    static const int MAX_MAYORES = 5;
+
+    // Totales de un tipo de sensor
+    struct FilaTipo {
+        char tipo;
+        int sensores;
+        long long lecturas;
+        size_t bytes;
+    };
+
+public:
+    /**
+     * @brief Suma de getBytesMemoria() de todos los sensores
+     */
+    static size_t totalFlota(const ListaGeneral* lista) {
+        size_t total = 0;
+        lista->iterar([&total](SensorBase* sensor) {
+            total += sensor->getBytesMemoria();
+        });
+        return total;
+    }
+
+    /**
+     * @brief Imprime bytes por tipo, bytes por lectura, total y los sensores más pesados
+     */
+    static void imprimir(const ListaGeneral* lista) {
+        FilaTipo filas[MAX_TIPOS];
+        int numFilas = 0;
+        SensorBase* mayores[MAX_MAYORES];
+        size_t bytesMayores[MAX_MAYORES];
+        int numMayores = 0;
+        size_t total = 0;
+        long long lecturas = 0;
+        int excedidos = 0;
+
+        lista->iterar([&](SensorBase* sensor) {
+            size_t bytes = sensor->getBytesMemoria();
+            total += bytes;
+            lecturas += sensor->getNumLecturas();
+            if (sensor->excedePresupuesto()) {
+                excedidos++;
+            }
+
+            int f = 0;
+            while (f < numFilas && filas[f].tipo != sensor->getTipo()) {
+                f++;
+            }
+            if (f == numFilas) {
+                if (numFilas == MAX_TIPOS) {
+                    f = MAX_TIPOS - 1;   // tipos sobrantes se suman a la última fila
+                } else {
+                    filas[f].tipo = sensor->getTipo();
+                    filas[f].sensores = 0;
+                    filas[f].lecturas = 0;
+                    filas[f].bytes = 0;
+                    numFilas++;
+                }
+            }
+            filas[f].sensores++;
+            filas[f].lecturas += sensor->getNumLecturas();
+            filas[f].bytes += bytes;
+
+            // Inserción ordenada en los MAX_MAYORES más pesados
+            int pos = numMayores < MAX_MAYORES ? numMayores++ : MAX_MAYORES;
+            while (pos > 0 && bytesMayores[pos - 1] < bytes) {
+                if (pos < MAX_MAYORES) {
+                    mayores[pos] = mayores[pos - 1];
+                    bytesMayores[pos] = bytesMayores[pos - 1];
+                }
+                pos--;
+            }
+            if (pos < MAX_MAYORES) {
+                mayores[pos] = sensor;
+                bytesMayores[pos] = bytes;
+            }
+        });
+
+        std::ios::fmtflags formato = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << "\n=== Memoria de la Flota ===" << std::endl;
+        std::cout << "Tipo   Sensores     Lecturas        Bytes  Bytes/lectura" << std::endl;
+        for (int f = 0; f < numFilas; f++) {
+            imprimirFila(filas[f].tipo, filas[f].sensores, filas[f].lecturas, filas[f].bytes);
+        }
+        imprimirFila('*', lista->getTamanio(), lecturas, total);
+        std::cout << "Total de la flota: " << total << " bytes ("
+                  << std::fixed << std::setprecision(2) << total / (1024.0 * 1024.0)
+                  << " MiB)" << std::endl;
+        if (numMayores > 0) {
+            std::cout << "Mayor consumo:" << std::endl;
+            for (int i = 0; i < numMayores; i++) {
+                std::cout << "  " << std::left << std::setw(12) << mayores[i]->getNombre()
+                          << std::right << std::setw(12) << bytesMayores[i] << " bytes  ("
+                          << mayores[i]->getNumLecturas() << " lecturas)" << std::endl;
+            }
+        }
+        if (SensorBase::presupuestoPorDefecto() > 0) {
+            std::cout << "Presupuesto por sensor: " << SensorBase::presupuestoPorDefecto()
+                      << " bytes" << std::endl;
+        }
+        if (excedidos > 0) {
+            std::cout << "⚠️  Sensores sobre su presupuesto: " << excedidos
+                      << " (se ajustan con la próxima lectura)" << std::endl;
+        }
+        std::cout << "===========================\n" << std::endl;
+        std::cout.flags(formato);
+        std::cout.precision(precision);
+    }
+
+    /**
+     * @brief Compacta el historial de todos los sensores
+     * @return Bytes liberados (diferencia de totalFlota antes y después)
+     */
+    static size_t compactarFlota(ListaGeneral* lista) {
+        size_t antes = totalFlota(lista);
+        lista->iterar([](SensorBase* sensor) {
+            sensor->compactar();
+        });
+        size_t despues = totalFlota(lista);
+        return antes > despues ? antes - despues : 0;
+    }
+
+    /**
+     * @brief Fija el presupuesto de los sensores existentes y de los nuevos
+     * @param bytes Máximo de bytes del historial por sensor (0 = sin límite)
+     */
+    static void fijarPresupuesto(ListaGeneral* lista, size_t bytes) {
+        SensorBase::presupuestoPorDefecto() = bytes;
+        lista->iterar([bytes](SensorBase* sensor) {
+            sensor->setPresupuesto(bytes);
+        });
+    }
+
+private:
+    static void imprimirFila(char tipo, int sensores, long long lecturas, size_t bytes) {
+        std::cout << "  " << tipo << "  " << std::setw(9) << sensores << std::setw(13) << lecturas
+                  << std::setw(13) << bytes << std::setw(15);
+        if (lecturas > 0) {
+            std::cout << std::fixed << std::setprecision(1)
+                      << static_cast<double>(bytes) / lecturas << std::endl;
+        } else {
+            std::cout << "-" << std::endl;
+        }
+    }
+};
+
+#endif // REPORTEMEMORIA_H
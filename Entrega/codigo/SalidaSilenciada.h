@@ -0,0 +1,44 @@
+/**
+ * @file SalidaSilenciada.h
+ * @brief Silencia temporalmente std::cout
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ */
+
+#ifndef SALIDASILENCIADA_H
+#define SALIDASILENCIADA_H
+
+#include <iostream>
+
+/**
+ * @class SalidaSilenciada
+ * @brief Desvía std::cout mientras el objeto existe
+ *
+ * @details
+ * Los constructores, destructores e inserciones de listas y sensores
+ * escriben en std::cout. Cuando se procesan miles de lecturas por segundo
+ * (pruebas de carga, modo por lotes) esa salida domina el tiempo de
+ * ejecución. Con el búfer nulo el flujo queda en estado de error y cada
+ * operador << retorna de inmediato sin formatear nada.
+ *
+ * std::cerr no se toca: los errores (puerto, generador, archivos) deben
+ * verse aunque la corrida esté silenciada.
+ */
+class SalidaSilenciada {
+private:
+    std::streambuf* originalCout;
+
+public:
+    SalidaSilenciada() : originalCout(std::cout.rdbuf(nullptr)) {}
+
+    ~SalidaSilenciada() {
+        // rdbuf() con un búfer válido también limpia el estado de error
+        std::cout.rdbuf(originalCout);
+    }
+
+    SalidaSilenciada(const SalidaSilenciada&) = delete;
+    SalidaSilenciada& operator=(const SalidaSilenciada&) = delete;
+};
+
+#endif // SALIDASILENCIADA_H
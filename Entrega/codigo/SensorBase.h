@@ -15,6 +15,10 @@
 
 #include <iostream>
 #include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include "AgregadoLecturas.h"
+#include "TablaSimbolos.h"
 
 /**
  * @class SensorBase
@@ -28,34 +32,40 @@
  * Características principales:
  * - Métodos virtuales puros para garantizar implementación en clases derivadas
  * - Destructor virtual para correcta liberación de memoria
- * - Identificador único para cada sensor
+ * - Identificador único para cada sensor, internado como entero denso
+ *   (ver TablaSimbolos) para que búsquedas y comparaciones no usen strcmp
  * 
  * @note Esta clase no puede ser instanciada directamente
  * 
+ * @see SensorTipado
  * @see SensorTemperatura
  * @see SensorPresion
  */
 class SensorBase {
 protected:
-    char nombre[50];  ///< Identificador único del sensor (máx. 50 caracteres)
+    uint32_t id;         ///< ID internado del sensor (máx. 49 caracteres de nombre)
+    const void* clase;   ///< Identificador de la clase concreta (ver SensorTipado::clase)
+    size_t presupuesto;  ///< Máximo de bytes del historial (0 = sin límite)
     
 public:
     /**
      * @brief Constructor de la clase base
-     * @param id Identificador único del sensor (por defecto "SENSOR")
-     * @details Inicializa el nombre del sensor con el ID proporcionado
+     * @param nombre Identificador único del sensor (por defecto "SENSOR")
+     * @param claseConcreta Identificador de la clase derivada, o nullptr
+     * @details Interna el nombre en la tabla global. El presupuesto de
+     *          memoria parte del valor por defecto global. La búsqueda por
+     *          ID la indexa la lista que contiene al sensor (ListaGeneral).
      */
-    SensorBase(const char* id = "SENSOR") {
-        std::strncpy(nombre, id, 49);
-        nombre[49] = '\0';
-    }
+    SensorBase(const char* nombre = "SENSOR", const void* claseConcreta = nullptr)
+        : id(TablaSimbolos::global().internar(nombre)), clase(claseConcreta),
+          presupuesto(presupuestoPorDefecto()) {}
     
     /**
      * @brief Destructor virtual
      * @details Garantiza la correcta destrucción de objetos derivados
      */
     virtual ~SensorBase() {
-        std::cout << "[Destructor SensorBase] Liberando sensor: " << nombre << std::endl;
+        std::cout << "[Destructor SensorBase] Liberando sensor: " << getNombre() << std::endl;
     }
     
     /**
@@ -74,13 +84,100 @@ public:
      */
     virtual void imprimirInfo() const = 0;
     
+    /**
+     * @brief Obtiene el número de lecturas almacenadas
+     * @return int Cantidad de lecturas en el historial del sensor
+     * @details Usado por el exportador de métricas para reportar
+     *          conteos por sensor sin conocer el tipo concreto
+     */
+    virtual int getNumLecturas() const = 0;
+    
+    /**
+     * @brief Obtiene la letra de tipo del sensor
+     * @return char 'T' (temperatura), 'P' (presión) o 'V' (vibración), igual que en el protocolo serial
+     */
+    virtual char getTipo() const = 0;
+    
+    /**
+     * @brief Agrega todas las lecturas del sensor a un resultado parcial
+     * @param parcial Agregado donde se acumulan cuenta, suma, mínimo y máximo
+     * @details No imprime nada; es la base de las consultas de flota.
+     *          Puede llamarse desde varios hilos mientras nadie inserte lecturas.
+     */
+    virtual void acumularLecturas(AgregadoLecturas& parcial) const = 0;
+    
+    /**
+     * @brief Bytes de heap que ocupa el sensor
+     * @return size_t Objeto, historial y lecturas, con el redondeo y la
+     *         cabecera del asignador (ver MemoriaHeap)
+     */
+    virtual size_t getBytesMemoria() const = 0;
+    
+    /**
+     * @brief Reescribe el historial en almacenamiento contiguo
+     * @details Sin efecto (O(1)) en sensores cuyo historial ya es contiguo:
+     *          vistas columnares o listas que ocupan justo su bloque
+     */
+    virtual void compactar() = 0;
+    
+    /**
+     * @brief Indica si el historial ocupa más que getPresupuesto()
+     * @return false sin presupuesto o con una sola lectura (siempre se
+     *         conserva la última). Tras la próxima lectura debe ser false:
+     *         un historial compactado que no cabe vuelve a nodos sueltos,
+     *         con a lo sumo presupuesto / costo de nodo lecturas.
+     */
+    virtual bool excedePresupuesto() const = 0;
+    
     /**
      * @brief Obtiene el nombre/ID del sensor
      * @return const char* Puntero al nombre del sensor
-     * @details Método público para acceder al identificador del sensor
+     * @details Método público para acceder al identificador del sensor.
+     *          El texto vive en la tabla de símbolos y no cambia de dirección.
      */
     const char* getNombre() const {
-        return nombre;
+        return TablaSimbolos::global().nombre(id);
+    }
+    
+    /**
+     * @brief Obtiene el ID internado del sensor
+     * @return uint32_t Entero denso asignado por TablaSimbolos
+     */
+    uint32_t getId() const {
+        return id;
+    }
+    
+    /**
+     * @brief Identificador de la clase concreta
+     * @return const void* Igual a SensorTipado<...>::clase() para los sensores
+     *         tipados; nullptr para otras derivadas
+     * @details No es virtual: la ingesta lo usa en cada lectura para
+     *          despachar con static_cast en lugar de dynamic_cast
+     */
+    const void* getClase() const {
+        return clase;
+    }
+    
+    /**
+     * @brief Fija el máximo de bytes del historial
+     * @param bytes Presupuesto (0 = sin límite)
+     * @details Se aplica en la próxima lectura: al superarlo se descartan
+     *          las lecturas más antiguas
+     */
+    void setPresupuesto(size_t bytes) {
+        presupuesto = bytes;
+    }
+    
+    size_t getPresupuesto() const {
+        return presupuesto;
+    }
+    
+    /**
+     * @brief Presupuesto con el que nacen los sensores nuevos (0 = sin límite)
+     */
+    static size_t& presupuestoPorDefecto() {
+        static size_t bytes = 0;
+        return bytes;
     }
 };
 
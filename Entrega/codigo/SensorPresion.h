@@ -1,80 +1,28 @@
 #ifndef SENSORPRESION_H
 #define SENSORPRESION_H
 
-#include "SensorBase.h"
-#include "ListaSensor.h"
-#include <iostream>
-#include <iomanip>
+#include "SensorTipado.h"
 
 /**
- * Clase concreta SensorPresion
- * Representa un sensor que maneja lecturas de tipo int (presión)
+ * Magnitud de presión
+ * Lecturas int en Pa, letra 'P' en el protocolo serial
  */
-class SensorPresion : public SensorBase {
-private:
-    ListaSensor<int>* historial;  // Lista interna de lecturas
-    
-public:
-    // Constructor
-    SensorPresion(const char* id = "P-000") : SensorBase(id) {
-        historial = new ListaSensor<int>();
-        std::cout << "[Sensor Presion] Creado: " << nombre << std::endl;
-    }
-    
-    // Destructor
-    ~SensorPresion() override {
-        std::cout << "[Destructor Sensor " << nombre << "]" << std::endl;
-        delete historial;
-    }
-    
-    // Agregar una nueva lectura
-    void agregarLectura(int valor) {
-        historial->insertarAlFinal(valor);
-        std::cout << "[Log] Nodo<int> " << valor << " agregado" << std::endl;
-    }
-    
-    // Implementación del método virtual puro
-    void procesarLectura() override {
-        if (historial->estaVacia()) {
-            std::cout << "[Sensor Presion] No hay lecturas para procesar" << std::endl;
-            return;
-        }
-        
-        // Calcular el promedio de las lecturas
-        int suma = 0;
-        int contador = 0;
-        
-        historial->iterar([&suma, &contador](int valor) {
-            suma += valor;
-            contador++;
-        });
-        
-        double promedio = static_cast<double>(suma) / contador;
-        std::cout << "[Sensor Presion] Promedio calculado: " 
-                  << std::fixed << std::setprecision(2) << promedio << std::endl;
-    }
-    
-    // Implementación del método virtual puro
-    void imprimirInfo() const override {
-        std::cout << "\n=== Información del Sensor ===" << std::endl;
-        std::cout << "Tipo: Sensor de Presión" << std::endl;
-        std::cout << "ID: " << nombre << std::endl;
-        std::cout << "Lecturas almacenadas: " << historial->getTamanio() << std::endl;
-        
-        if (!historial->estaVacia()) {
-            std::cout << "Historial de lecturas: ";
-            historial->iterar([](int valor) {
-                std::cout << valor << " Pa ";
-            });
-            std::cout << std::endl;
-        }
-        std::cout << "==============================\n" << std::endl;
-    }
-    
-    // Obtener el historial
-    ListaSensor<int>* getHistorial() {
-        return historial;
-    }
+struct MagnitudPresion {
+    typedef int Valor;
+    static const char TIPO = 'P';
+    static const Contador CONTADOR = Contador::LecturasPresion;
+    static const int DECIMALES = 0;
+    static const char* nombre() { return "Sensor de Presión"; }
+    static const char* etiquetaCreado() { return "[Sensor Presion]"; }
+    static const char* etiquetaProceso() { return "[Sensor Presion]"; }
+    static const char* nombreValor() { return "int"; }
+    static const char* unidad() { return " Pa"; }
+    static const char* idPorDefecto() { return "P-000"; }
 };
 
+/**
+ * Sensor de presión: procesarLectura() calcula el promedio
+ */
+using SensorPresion = SensorTipado<MagnitudPresion, PoliticaPromedio>;
+
 #endif // SENSORPRESION_H
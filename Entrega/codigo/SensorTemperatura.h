@@ -1,79 +1,28 @@
 #ifndef SENSORTEMPERATURA_H
 #define SENSORTEMPERATURA_H
 
-#include "SensorBase.h"
-#include "ListaSensor.h"
-#include <iostream>
-#include <iomanip>
+#include "SensorTipado.h"
 
 /**
- * Clase concreta SensorTemperatura
- * Representa un sensor que maneja lecturas de tipo float (temperatura)
+ * Magnitud de temperatura
+ * Lecturas float en °C, letra 'T' en el protocolo serial
  */
-class SensorTemperatura : public SensorBase {
-private:
-    ListaSensor<float>* historial;  // Lista interna de lecturas
-    
-public:
-    // Constructor
-    SensorTemperatura(const char* id = "T-000") : SensorBase(id) {
-        historial = new ListaSensor<float>();
-        std::cout << "[Sensor Temperatura] Creado: " << nombre << std::endl;
-    }
-    
-    // Destructor
-    ~SensorTemperatura() override {
-        std::cout << "[Destructor Sensor " << nombre << "]" << std::endl;
-        delete historial;
-    }
-    
-    // Agregar una nueva lectura
-    void agregarLectura(float valor) {
-        historial->insertarAlFinal(valor);
-        std::cout << "[Log] Nodo<float> " << std::fixed << std::setprecision(1) 
-                  << valor << " agregado" << std::endl;
-    }
-    
-    // Implementación del método virtual puro
-    void procesarLectura() override {
-        if (historial->estaVacia()) {
-            std::cout << "[Sensor Temp] No hay lecturas para procesar" << std::endl;
-            return;
-        }
-        
-        // Calcular el valor más bajo
-        float minimo = 999999.0f;
-        historial->iterar([&minimo](float valor) {
-            if (valor < minimo) {
-                minimo = valor;
-            }
-        });
-        
-        std::cout << "[Sensor Temp] Lectura minima calculada: " 
-                  << std::fixed << std::setprecision(1) << minimo << std::endl;
-    }
-    
-    // Implementación del método virtual puro
-    void imprimirInfo() const override {
-        std::cout << "\n=== Información del Sensor ===" << std::endl;
-        std::cout << "Tipo: Sensor de Temperatura" << std::endl;
-        std::cout << "ID: " << nombre << std::endl;
-        std::cout << "Lecturas almacenadas: " << historial->getTamanio() << std::endl;
-        
-        if (!historial->estaVacia()) {
-            std::cout << "Historial de lecturas: ";
-            historial->iterar([](float valor) {
-                std::cout << std::fixed << std::setprecision(1) << valor << "°C ";
-            });
-            std::cout << std::endl;
-        }
-        std::cout << "==============================\n" << std::endl;
-    }
-    
-    // Obtener el historial
-    ListaSensor<float>* getHistorial() {
-        return historial;
-    }
+struct MagnitudTemperatura {
+    typedef float Valor;
+    static const char TIPO = 'T';
+    static const Contador CONTADOR = Contador::LecturasTemperatura;
+    static const int DECIMALES = 1;
+    static const char* nombre() { return "Sensor de Temperatura"; }
+    static const char* etiquetaCreado() { return "[Sensor Temperatura]"; }
+    static const char* etiquetaProceso() { return "[Sensor Temp]"; }
+    static const char* nombreValor() { return "float"; }
+    static const char* unidad() { return "°C"; }
+    static const char* idPorDefecto() { return "T-000"; }
 };
 
+/**
+ * Sensor de temperatura: procesarLectura() calcula la lectura mínima
+ */
+using SensorTemperatura = SensorTipado<MagnitudTemperatura, PoliticaMinimo>;
+
 #endif // SENSORTEMPERATURA_H
@@ -0,0 +1,250 @@
+/**
+ * @file SensorTipado.h
+ * @brief Sensor genérico parametrizado por magnitud y política de procesamiento
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * SensorTemperatura y SensorPresion eran copias que sólo diferían en el
+ * tipo de lectura y en el cálculo de procesarLectura(). Ambos son ahora
+ * alias de SensorTipado; un tipo nuevo se declara con una estructura de
+ * magnitud y una política (ver SensorVibracion.h).
+ */
+
+#ifndef SENSORTIPADO_H
+#define SENSORTIPADO_H
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include "ListaSensor.h"
+#include "MemoriaHeap.h"
+#include "ExportadorLecturas.h"
+#include "Metricas.h"
+#include "MotorReglas.h"
+#include "PoliticasSensor.h"
+#include "SensorBase.h"
+
+/**
+ * @class SensorTipado
+ * @brief Sensor con historial de lecturas de tipo Magnitud::Valor
+ * @tparam Magnitud Rasgos del tipo de sensor. Debe declarar:
+ *         - @c Valor: tipo de las lecturas (float, int, double...)
+ *         - @c TIPO: letra del protocolo serial ('T', 'P', 'V'...)
+ *         - @c CONTADOR: Contador de Metricas para cada lectura
+ *         - @c DECIMALES: precisión al mostrar lecturas
+ *         - nombre(), etiquetaCreado(), etiquetaProceso(), nombreValor(),
+ *           unidad() e idPorDefecto(): textos de consola
+ * @tparam Politica Cálculo de procesarLectura() (ver PoliticasSensor.h)
+ *
+ * @details
+ * La política se resuelve en tiempo de compilación y su acumulador se
+ * expande en línea dentro del recorrido del historial. La ingesta
+ * identifica la clase concreta con getClase() == clase() y llama a
+ * agregarLectura() con static_cast, sin llamadas virtuales por lectura.
+ *
+ * Ejemplo de uso:
+ * @code
+ * using SensorHumedad = SensorTipado<MagnitudHumedad, PoliticaPromedio>;
+ * SensorHumedad* s = new SensorHumedad("H-001");
+ * s->agregarLectura(41.5);
+ * @endcode
+ */
+template <typename Magnitud, typename Politica>
+class SensorTipado : public SensorBase {
+public:
+    typedef typename Magnitud::Valor Valor;             ///< Tipo de las lecturas
+    typedef Magnitud MagnitudSensor;                    ///< Rasgos del sensor
+    typedef Politica PoliticaSensor;                    ///< Política de procesamiento
+    static const char TIPO = Magnitud::TIPO;            ///< Letra del protocolo
+
+private:
+    ListaSensor<Valor>* historial;  // Lista interna de lecturas
+
+public:
+    // Constructor
+    SensorTipado(const char* id = Magnitud::idPorDefecto()) : SensorBase(id, clase()) {
+        historial = new ListaSensor<Valor>();
+        std::cout << Magnitud::etiquetaCreado() << " Creado: " << getNombre() << std::endl;
+    }
+
+    // Destructor
+    ~SensorTipado() override {
+        std::cout << "[Destructor Sensor " << getNombre() << "]" << std::endl;
+        delete historial;
+    }
+
+    /**
+     * @brief Identificador de esta instanciación (comparable con getClase())
+     */
+    static const void* clase() {
+        static const char marca = 0;
+        return &marca;
+    }
+
+    /**
+     * @brief Agrega una lectura respetando el presupuesto de memoria
+     * @param valor Lectura
+     * @param llegadaNs Llegada de la lectura al puerto, para la latencia de
+     *                  las alertas (0 = sin marca)
+     * @details Si el historial no cabe en getPresupuesto() se descartan las
+     *          lecturas más antiguas (Contador::LecturasExpulsadas).
+     */
+    void agregarLectura(Valor valor, uint64_t llegadaNs = 0) {
+        int expulsadas = historial->insertarAcotado(valor, presupuesto);
+        if (expulsadas > 0) {
+            Metricas::incrementar(Contador::LecturasExpulsadas, static_cast<uint64_t>(expulsadas));
+        }
+        Metricas::incrementar(Magnitud::CONTADOR);
+        MotorReglas::global().evaluar(id, static_cast<float>(valor), llegadaNs);
+        ExportadorLecturas& exportador = ExportadorLecturas::global();
+        if (exportador.estaActivo()) {
+            exportador.registrar(id, Magnitud::TIPO, valor);
+        }
+        escribirLog(std::cout << prefijoLog(), valor,
+                    std::integral_constant<bool, std::is_floating_point<Valor>::value>())
+            << " agregado" << std::endl;
+    }
+
+    /**
+     * @brief Aplica la política a @p n lecturas contiguas e imprime el resultado
+     * @details Compartido con las vistas del almacén columnar.
+     */
+    static void procesarSegmento(const Valor* valores, int n) {
+        typename Politica::template Acumulador<Valor> acumulador;
+        for (int i = 0; i < n; i++) {
+            acumulador.agregar(valores[i]);
+        }
+        imprimirResultado(acumulador.resultado());
+    }
+
+    // Implementación del método virtual puro
+    void procesarLectura() override {
+        if (historial->estaVacia()) {
+            std::cout << Magnitud::etiquetaProceso() << " No hay lecturas para procesar" << std::endl;
+            return;
+        }
+
+        typename Politica::template Acumulador<Valor> acumulador;
+        historial->iterar([&acumulador](Valor valor) {
+            acumulador.agregar(valor);
+        });
+        imprimirResultado(acumulador.resultado());
+    }
+
+    // Implementación del método virtual puro
+    void imprimirInfo() const override {
+        std::cout << "\n=== Información del Sensor ===" << std::endl;
+        std::cout << "Tipo: " << Magnitud::nombre() << std::endl;
+        std::cout << "ID: " << getNombre() << std::endl;
+        std::cout << "Lecturas almacenadas: " << historial->getTamanio() << std::endl;
+        imprimirMemoria();
+
+        if (!historial->estaVacia()) {
+            std::cout << "Historial de lecturas: ";
+            historial->iterar([](Valor valor) {
+                std::cout << std::fixed << std::setprecision(Magnitud::DECIMALES) << valor
+                          << Magnitud::unidad() << " ";
+            });
+            std::cout << std::endl;
+        }
+        std::cout << "==============================\n" << std::endl;
+    }
+
+    // Implementación del método virtual puro
+    int getNumLecturas() const override {
+        return historial->getTamanio();
+    }
+
+    // Implementación del método virtual puro
+    char getTipo() const override {
+        return Magnitud::TIPO;
+    }
+
+    // Implementación del método virtual puro
+    void acumularLecturas(AgregadoLecturas& parcial) const override {
+        historial->iterar([&parcial](Valor valor) {
+            parcial.agregar(valor);
+        });
+    }
+
+    // Implementación del método virtual puro
+    size_t getBytesMemoria() const override {
+        return MemoriaHeap::estimar(sizeof(*this)) +
+               MemoriaHeap::costo(historial, sizeof(ListaSensor<Valor>)) + historial->getBytes();
+    }
+
+    // Implementación del método virtual puro
+    void compactar() override {
+        historial->compactar();
+    }
+
+    // Implementación del método virtual puro
+    bool excedePresupuesto() const override {
+        return presupuesto > 0 && historial->getTamanio() > 1 && historial->getBytes() > presupuesto;
+    }
+
+    // Obtener el historial
+    ListaSensor<Valor>* getHistorial() {
+        return historial;
+    }
+
+private:
+    void imprimirMemoria() const {
+        size_t total = getBytesMemoria();
+        int lecturas = historial->getTamanio();
+        std::cout << "Memoria: " << total << " bytes";
+        if (lecturas > 0) {
+            std::cout << " (" << std::fixed << std::setprecision(1)
+                      << static_cast<double>(historial->getBytes()) / lecturas
+                      << " bytes/lectura para un dato de " << sizeof(Valor) << " bytes"
+                      << (historial->estaCompactada() ? ", compactado" : "") << ")";
+        }
+        std::cout << std::endl;
+        std::cout << "Presupuesto: ";
+        if (presupuesto > 0) {
+            std::cout << presupuesto << " bytes" << std::endl;
+        } else {
+            std::cout << "sin límite" << std::endl;
+        }
+    }
+
+    // "[Log] Nodo<tipo> " armado una sola vez: agregarLectura() corre en cada lectura
+    static const std::string& prefijoLog() {
+        static const std::string prefijo =
+            std::string("[Log] Nodo<") + Magnitud::nombreValor() + "> ";
+        return prefijo;
+    }
+
+    // Sólo los valores de punto flotante necesitan fijar el formato
+    static std::ostream& escribirLog(std::ostream& os, Valor valor, std::true_type) {
+        return os << std::fixed << std::setprecision(Magnitud::DECIMALES) << valor;
+    }
+
+    static std::ostream& escribirLog(std::ostream& os, Valor valor, std::false_type) {
+        return os << valor;
+    }
+
+    static void imprimirResultado(double resultado) {
+        std::cout << Magnitud::etiquetaProceso() << " " << Politica::descripcion() << ": "
+                  << std::fixed << std::setprecision(Politica::DECIMALES) << resultado << std::endl;
+    }
+};
+
+template <typename Magnitud, typename Politica>
+const char SensorTipado<Magnitud, Politica>::TIPO;
+
+/**
+ * @brief Convierte @p sensor al tipo concreto @p Sensor si corresponde
+ * @return Puntero tipado, o nullptr si @p sensor es de otra clase
+ * @details Compara el identificador de clase guardado en SensorBase:
+ *          una comparación de punteros en lugar de dynamic_cast.
+ */
+template <typename Sensor>
+inline Sensor* comoSensor(SensorBase* sensor) {
+    return (sensor != nullptr && sensor->getClase() == Sensor::clase())
+               ? static_cast<Sensor*>(sensor) : nullptr;
+}
+
+#endif // SENSORTIPADO_H
@@ -0,0 +1,28 @@
+#ifndef SENSORVIBRACION_H
+#define SENSORVIBRACION_H
+
+#include "SensorTipado.h"
+
+/**
+ * Magnitud de vibración
+ * Lecturas double en mm/s, letra 'V' en el protocolo serial ("V V-001 3.142")
+ */
+struct MagnitudVibracion {
+    typedef double Valor;
+    static const char TIPO = 'V';
+    static const Contador CONTADOR = Contador::LecturasVibracion;
+    static const int DECIMALES = 3;
+    static const char* nombre() { return "Sensor de Vibración"; }
+    static const char* etiquetaCreado() { return "[Sensor Vibracion]"; }
+    static const char* etiquetaProceso() { return "[Sensor Vibracion]"; }
+    static const char* nombreValor() { return "double"; }
+    static const char* unidad() { return " mm/s"; }
+    static const char* idPorDefecto() { return "V-000"; }
+};
+
+/**
+ * Sensor de vibración: procesarLectura() calcula el valor RMS
+ */
+using SensorVibracion = SensorTipado<MagnitudVibracion, PoliticaRMS>;
+
+#endif // SENSORVIBRACION_H
@@ -3,31 +3,53 @@
 
 #include <string>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <termios.h>
+#include <cerrno>
 #include <cstring>
+#include <cstdint>
+#include "Metricas.h"
 
 /**
  * Clase para leer datos del puerto serial (Arduino)
  * Compatible con Linux/Mac
  */
 class SerialPort {
+public:
+    static const size_t TAMANIO_BUFFER = 4096;
+    
 private:
     int fd;  // File descriptor del puerto
     bool isOpen;
+    char buffer[TAMANIO_BUFFER];  // Bytes recibidos aún no consumidos
+    size_t inicioBuffer;
+    size_t finBuffer;
+    uint64_t marcaBuffer;   // Llegada del byte pendiente más antiguo (Metricas::ahoraNs)
+    uint64_t marcaLectura;  // Llegada de lo último devuelto por leerLinea()/leerBytes()
+    std::function<void()> tareaPeriodica;   // Ver setTareaPeriodica()
+    uint64_t periodoTareaNs;
+    uint64_t ultimaTareaNs;
     
 public:
-    SerialPort() : fd(-1), isOpen(false) {}
+    SerialPort()
+        : fd(-1), isOpen(false), inicioBuffer(0), finBuffer(0), marcaBuffer(0), marcaLectura(0),
+          periodoTareaNs(0), ultimaTareaNs(0) {}
     
     /**
      * Abre el puerto serial
-     * @param puerto Ruta del puerto (ej: /dev/ttyACM0)
+     * @param puerto Ruta del puerto (ej: /dev/ttyACM0) o el extremo esclavo
+     *               de un pseudo-terminal (ej: /dev/pts/3)
      * @param baudRate Velocidad (por defecto 9600)
+     * @param esperarArduino Si es true espera 2 s a que el Arduino se reinicie;
+     *                       un pseudo-terminal no lo necesita
      */
-    bool abrir(const std::string& puerto, int baudRate = 9600) {
-        fd = open(puerto.c_str(), O_RDONLY | O_NOCTTY);
+    bool abrir(const std::string& puerto, int baudRate = 9600, bool esperarArduino = true) {
+        // Lectura/escritura: el host puede enviar comandos de protocolo
+        fd = open(puerto.c_str(), O_RDWR | O_NOCTTY);
         
         if (fd < 0) {
             std::cerr << "Error: No se pudo abrir el puerto " << puerto << std::endl;
@@ -49,7 +71,30 @@ public:
             case 38400: baud = B38400; break;
             case 57600: baud = B57600; break;
             case 115200: baud = B115200; break;
-            default:    baud = B9600;  break;
+#ifdef B230400
+            case 230400: baud = B230400; break;
+#endif
+#ifdef B460800
+            case 460800: baud = B460800; break;
+#endif
+#ifdef B500000
+            case 500000: baud = B500000; break;
+#endif
+#ifdef B921600
+            case 921600: baud = B921600; break;
+#endif
+#ifdef B1000000
+            case 1000000: baud = B1000000; break;
+#endif
+#ifdef B2000000
+            case 2000000: baud = B2000000; break;
+#endif
+            default:
+                std::cerr << "Advertencia: velocidad " << baudRate
+                          << " no soportada, usando 9600" << std::endl;
+                baudRate = 9600;
+                baud = B9600;
+                break;
         }
         
         cfsetispeed(&options, baud);
@@ -66,6 +111,9 @@ public:
         // Modo raw
         options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
         options.c_iflag &= ~(IXON | IXOFF | IXANY);
+        // Sin traducir CR/NL ni recortar el bit 8: las tramas binarias
+        // pueden contener 0x0D, 0x0A o bytes >= 0x80
+        options.c_iflag &= ~(ICRNL | INLCR | IGNCR | ISTRIP | IGNBRK | BRKINT | PARMRK);
         options.c_oflag &= ~OPOST;
         
         // Aplicar configuración
@@ -79,7 +127,9 @@ public:
                   << baudRate << " bps" << std::endl;
         
         // Esperar un momento para que Arduino se estabilice
-        sleep(2);
+        if (esperarArduino) {
+            sleep(2);
+        }
         
         return true;
     }
@@ -95,36 +145,131 @@ public:
         }
         
         linea.clear();
-        char c;
-        ssize_t bytesRead;
+        uint64_t marca = 0;
         
         while (true) {
-            bytesRead = read(fd, &c, 1);
-            
-            if (bytesRead < 0) {
-                std::cerr << "Error al leer del puerto serial" << std::endl;
+            if (inicioBuffer == finBuffer && !rellenar()) {
                 return false;
             }
             
-            if (bytesRead == 0) {
-                // No hay datos disponibles, continuar esperando
-                usleep(10000);  // Esperar 10ms
-                continue;
+            // Buscar el fin de línea dentro de lo ya recibido
+            const char* ini = buffer + inicioBuffer;
+            const char* fin = buffer + finBuffer;
+            const char* p = ini;
+            while (p < fin && *p != '\n' && *p != '\r') {
+                p++;
+            }
+            if (linea.empty() && p > ini) {
+                marca = marcaBuffer;   // La línea empieza en este bloque
             }
+            linea.append(ini, p - ini);
+            inicioBuffer = p - buffer;
             
             // Si es fin de línea, retornar
-            if (c == '\n' || c == '\r') {
+            if (p < fin) {
+                inicioBuffer++;
                 if (!linea.empty()) {
+                    marcaLectura = marca;
+                    Metricas::incrementar(Contador::LineasLeidas);
                     return true;
                 }
-                continue;
             }
-            
-            // Agregar carácter a la línea
-            linea += c;
         }
     }
     
+    /**
+     * Lee bytes crudos (protocolo binario)
+     * @param destino Búfer de salida
+     * @param maximo Capacidad de destino
+     * @return Bytes copiados (al menos 1), o 0 si hay error
+     */
+    size_t leerBytes(unsigned char* destino, size_t maximo) {
+        if (!isOpen || fd < 0 || maximo == 0) {
+            return 0;
+        }
+        if (inicioBuffer == finBuffer && !rellenar()) {
+            return 0;
+        }
+        size_t n = finBuffer - inicioBuffer;
+        if (n > maximo) {
+            n = maximo;
+        }
+        std::memcpy(destino, buffer + inicioBuffer, n);
+        inicioBuffer += n;
+        marcaLectura = marcaBuffer;
+        return n;
+    }
+    
+    /**
+     * Instante en que llegaron al puerto los primeros bytes de lo último
+     * devuelto por leerLinea() o leerBytes()
+     * @return Metricas::ahoraNs() tomado al volver read(); incluye la espera
+     *         en el búfer y en fragmentos anteriores de la misma línea
+     */
+    uint64_t getMarcaLlegada() const {
+        return marcaLectura;
+    }
+    
+    /**
+     * Espera hasta tener al menos @p minimo bytes recibidos sin consumirlos
+     * @param datos Recibe un puntero a los bytes pendientes
+     * @param minimo Bytes deseados (se limita a la capacidad del búfer)
+     * @return Bytes disponibles en @p datos (puede ser menos si hubo error)
+     */
+    size_t espiar(const unsigned char** datos, size_t minimo) {
+        if (minimo > TAMANIO_BUFFER) {
+            minimo = TAMANIO_BUFFER;
+        }
+        if (inicioBuffer > 0) {
+            // Compactar para dejar espacio al final
+            std::memmove(buffer, buffer + inicioBuffer, finBuffer - inicioBuffer);
+            finBuffer -= inicioBuffer;
+            inicioBuffer = 0;
+        }
+        while (isOpen && finBuffer < minimo && rellenar()) {
+        }
+        *datos = reinterpret_cast<const unsigned char*>(buffer);
+        return finBuffer;
+    }
+    
+    /**
+     * Registra una tarea que corre en el hilo lector cada @p periodoMs
+     * @param periodoMs Período en milisegundos (> 0)
+     * @param tarea Función a invocar (p. ej. MotorReglas::revisarInactividad)
+     * @details Mientras se espera un byte, read() se precede de un poll()
+     *          que vence a lo sumo al cumplirse el período, así la tarea
+     *          corre aunque el enlace quede en silencio. Con datos llegando
+     *          se invoca entre lecturas al cumplirse el período.
+     */
+    void setTareaPeriodica(int periodoMs, std::function<void()> tarea) {
+        tareaPeriodica = tarea;
+        periodoTareaNs = static_cast<uint64_t>(periodoMs > 0 ? periodoMs : 1) * 1000000ULL;
+        ultimaTareaNs = Metricas::ahoraNs();
+    }
+    
+    /**
+     * Envía bytes al Arduino (comandos de negociación de protocolo)
+     * @return true si se escribieron todos los bytes
+     */
+    bool escribir(const char* datos, size_t longitud) {
+        if (!isOpen || fd < 0) {
+            return false;
+        }
+        while (longitud > 0) {
+            ssize_t n = write(fd, datos, longitud);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Error al escribir en el puerto serial" << std::endl;
+                return false;
+            }
+            datos += n;
+            longitud -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+    
     /**
      * Verifica si el puerto está abierto
      */
@@ -140,6 +285,8 @@ public:
             close(fd);
             fd = -1;
             isOpen = false;
+            inicioBuffer = 0;
+            finBuffer = 0;
             std::cout << "Puerto serial cerrado" << std::endl;
         }
     }
@@ -150,6 +297,89 @@ public:
     ~SerialPort() {
         cerrar();
     }
+    
+private:
+    /**
+     * Agrega al búfer lo que el sistema tenga disponible (bloqueante)
+     * @return false si hubo error o el otro extremo se cerró
+     */
+    bool rellenar() {
+        if (inicioBuffer == finBuffer) {
+            inicioBuffer = 0;
+            finBuffer = 0;
+        }
+        if (finBuffer == TAMANIO_BUFFER) {
+            return true;
+        }
+        
+        bool colgado = false;
+        while (true) {
+            if (tareaPeriodica && !esperarDatos(colgado)) {
+                continue;   // Venció el período sin datos
+            }
+            ssize_t bytesRead = read(fd, buffer + finBuffer, TAMANIO_BUFFER - finBuffer);
+            
+            if (bytesRead < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EIO) {
+                    // El otro extremo se cerró (Arduino desconectado o
+                    // generador de carga detenido)
+                    std::cerr << "Puerto serial desconectado" << std::endl;
+                } else {
+                    std::cerr << "Error al leer del puerto serial" << std::endl;
+                }
+                return false;
+            }
+            
+            if (bytesRead == 0) {
+                if (colgado) {
+                    // Tras poll() el cierre del otro extremo llega como 0, no EIO
+                    std::cerr << "Puerto serial desconectado" << std::endl;
+                    return false;
+                }
+                // No hay datos disponibles, continuar esperando
+                usleep(10000);  // Esperar 10ms
+                continue;
+            }
+            
+            if (finBuffer == 0) {
+                marcaBuffer = Metricas::ahoraNs();   // Si quedaban bytes, su marca es anterior
+            }
+            finBuffer += static_cast<size_t>(bytesRead);
+            Metricas::incrementar(Contador::BytesLeidos, static_cast<uint64_t>(bytesRead));
+            return true;
+        }
+    }
+    
+    /**
+     * Corre la tarea periódica si venció y espera datos hasta el próximo período
+     * @param colgado Se pone en true si el otro extremo se cerró
+     * @return true si hay algo para read() (datos, error o cierre); false
+     *         si el período venció antes
+     */
+    bool esperarDatos(bool& colgado) {
+        uint64_t ahora = Metricas::ahoraNs();
+        if (ahora - ultimaTareaNs >= periodoTareaNs) {
+            ultimaTareaNs = ahora;
+            tareaPeriodica();
+        }
+        uint64_t restanteNs = ultimaTareaNs + periodoTareaNs - Metricas::ahoraNs();
+        if (restanteNs > periodoTareaNs) {
+            restanteNs = 0;   // La tarea tardó más que un período
+        }
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int listos = poll(&pfd, 1, static_cast<int>(restanteNs / 1000000ULL) + 1);
+        if (listos < 0 && errno == EINTR) {
+            return false;
+        }
+        colgado = listos > 0 && (pfd.revents & POLLHUP) != 0;
+        return listos != 0;
+    }
 };
 
 #endif // SERIALPORT_H
@@ -0,0 +1,223 @@
+/**
+ * @file TablaSimbolos.h
+ * @brief Internado de nombres de sensores en identificadores enteros densos
+ * @author Sistema de Gestión IoT
+ * @date Octubre 2026
+ * @version 3.1
+ *
+ * Cada nombre de sensor ("T-001", "P-105", ...) se registra una sola vez
+ * y recibe un ID de 32 bits consecutivo (0, 1, 2, ...). A partir de ahí
+ * las comparaciones, búsquedas e índices usan el entero; el texto sólo
+ * se recupera para mostrarlo.
+ */
+
+#ifndef TABLASIMBOLOS_H
+#define TABLASIMBOLOS_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @class TablaSimbolos
+ * @brief Tabla hash de direccionamiento abierto nombre -> ID denso
+ *
+ * @details
+ * - Los nombres se copian a bloques de 4 KB que nunca se mueven, por lo
+ *   que el puntero devuelto por nombre() es estable.
+ * - El arreglo @c nombres está indexado por ID (resolución O(1)).
+ * - Las ranuras del hash guardan sólo el ID; la comparación con el texto
+ *   se hace únicamente cuando coincide el hash de 32 bits.
+ *
+ * @note No es segura entre hilos: se usa desde el hilo de ingesta (los
+ *       hilos de parseo por lotes trabajan con texto y el internado ocurre
+ *       en la fase secuencial de registro).
+ *
+ * Ejemplo de uso:
+ * @code
+ * uint32_t id = TablaSimbolos::global().internar("T-001");
+ * const char* texto = TablaSimbolos::global().nombre(id);  // "T-001"
+ * @endcode
+ */
+class TablaSimbolos {
+public:
+    static const uint32_t SIN_ID = 0xFFFFFFFFu;   ///< Valor para "no internado"
+    static const size_t LARGO_MAXIMO = 49;        ///< Los nombres más largos se truncan
+
+private:
+    static const size_t TAMANIO_BLOQUE = 4096;
+
+    // Bloque del almacén de texto (lista enlazada simple)
+    struct BloqueTexto {
+        char datos[TAMANIO_BLOQUE];
+        BloqueTexto* siguiente;
+    };
+
+    uint32_t* ranuras;       // ID por ranura, o SIN_ID si está vacía
+    uint32_t* hashes;        // Hash de cada ID (evita recalcular al crecer)
+    const char** nombres;    // Texto de cada ID
+    uint32_t capacidadRanuras;
+    uint32_t capacidadIds;
+    uint32_t numIds;
+    BloqueTexto* bloques;
+    size_t usadoBloque;
+
+public:
+    TablaSimbolos()
+        : ranuras(nullptr), hashes(nullptr), nombres(nullptr), capacidadRanuras(0),
+          capacidadIds(0), numIds(0), bloques(nullptr), usadoBloque(TAMANIO_BLOQUE) {}
+
+    ~TablaSimbolos() {
+        delete[] ranuras;
+        delete[] hashes;
+        delete[] nombres;
+        while (bloques != nullptr) {
+            BloqueTexto* temp = bloques;
+            bloques = bloques->siguiente;
+            delete temp;
+        }
+    }
+
+    TablaSimbolos(const TablaSimbolos&) = delete;
+    TablaSimbolos& operator=(const TablaSimbolos&) = delete;
+
+    /**
+     * @brief Tabla compartida por todo el programa
+     */
+    static TablaSimbolos& global() {
+        static TablaSimbolos tabla;
+        return tabla;
+    }
+
+    /**
+     * @brief Devuelve el ID de @p nombre, registrándolo si es nuevo
+     */
+    uint32_t internar(const char* nombre) {
+        size_t largo = largoNombre(nombre);
+        uint32_t h = hash(nombre, largo);
+        uint32_t id = buscarConHash(nombre, largo, h);
+        if (id != SIN_ID) {
+            return id;
+        }
+
+        if ((numIds + 1) * 2 > capacidadRanuras) {
+            crecerRanuras();
+        }
+        if (numIds == capacidadIds) {
+            crecerIds();
+        }
+        id = numIds++;
+        nombres[id] = copiarTexto(nombre, largo);
+        hashes[id] = h;
+        insertarRanura(id, h);
+        return id;
+    }
+
+    /**
+     * @brief Busca un nombre sin registrarlo
+     * @return ID o SIN_ID si nunca fue internado
+     */
+    uint32_t buscar(const char* nombre) const {
+        size_t largo = largoNombre(nombre);
+        return buscarConHash(nombre, largo, hash(nombre, largo));
+    }
+
+    /**
+     * @brief Texto asociado a @p id (sólo para mostrar)
+     */
+    const char* nombre(uint32_t id) const {
+        return id < numIds ? nombres[id] : "?";
+    }
+
+    /**
+     * @brief Cantidad de nombres internados (los IDs válidos son 0..tamanio()-1)
+     */
+    uint32_t tamanio() const {
+        return numIds;
+    }
+
+private:
+    static size_t largoNombre(const char* nombre) {
+        size_t largo = std::strlen(nombre);
+        return largo > LARGO_MAXIMO ? LARGO_MAXIMO : largo;
+    }
+
+    // FNV-1a de 32 bits
+    static uint32_t hash(const char* texto, size_t largo) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < largo; i++) {
+            h ^= static_cast<unsigned char>(texto[i]);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    uint32_t buscarConHash(const char* nombre, size_t largo, uint32_t h) const {
+        if (capacidadRanuras == 0) {
+            return SIN_ID;
+        }
+        uint32_t mascara = capacidadRanuras - 1;
+        for (uint32_t i = h & mascara; ; i = (i + 1) & mascara) {
+            uint32_t id = ranuras[i];
+            if (id == SIN_ID) {
+                return SIN_ID;
+            }
+            if (hashes[id] == h && std::strncmp(nombres[id], nombre, largo) == 0 &&
+                nombres[id][largo] == '\0') {
+                return id;
+            }
+        }
+    }
+
+    void insertarRanura(uint32_t id, uint32_t h) {
+        uint32_t mascara = capacidadRanuras - 1;
+        uint32_t i = h & mascara;
+        while (ranuras[i] != SIN_ID) {
+            i = (i + 1) & mascara;
+        }
+        ranuras[i] = id;
+    }
+
+    void crecerRanuras() {
+        uint32_t nueva = capacidadRanuras == 0 ? 64 : capacidadRanuras * 2;
+        delete[] ranuras;
+        ranuras = new uint32_t[nueva];
+        for (uint32_t i = 0; i < nueva; i++) {
+            ranuras[i] = SIN_ID;
+        }
+        capacidadRanuras = nueva;
+        for (uint32_t id = 0; id < numIds; id++) {
+            insertarRanura(id, hashes[id]);
+        }
+    }
+
+    void crecerIds() {
+        uint32_t nueva = capacidadIds == 0 ? 32 : capacidadIds * 2;
+        const char** nuevosNombres = new const char*[nueva];
+        uint32_t* nuevosHashes = new uint32_t[nueva];
+        if (numIds > 0) {
+            std::memcpy(nuevosNombres, nombres, sizeof(const char*) * numIds);
+            std::memcpy(nuevosHashes, hashes, sizeof(uint32_t) * numIds);
+        }
+        delete[] nombres;
+        delete[] hashes;
+        nombres = nuevosNombres;
+        hashes = nuevosHashes;
+        capacidadIds = nueva;
+    }
+
+    const char* copiarTexto(const char* texto, size_t largo) {
+        if (largo + 1 > TAMANIO_BLOQUE - usadoBloque) {
+            BloqueTexto* nuevo = new BloqueTexto;
+            nuevo->siguiente = bloques;
+            bloques = nuevo;
+            usadoBloque = 0;
+        }
+        char* destino = bloques->datos + usadoBloque;
+        std::memcpy(destino, texto, largo);
+        destino[largo] = '\0';
+        usadoBloque += largo + 1;
+        return destino;
+    }
+};
+
+#endif // TABLASIMBOLOS_H
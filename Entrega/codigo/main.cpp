@@ -1,16 +1,29 @@
 #include <iostream>
 #include <string>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include "SensorBase.h"
 #include "SensorTemperatura.h"
 #include "SensorPresion.h"
+#include "SensorVibracion.h"
 #include "ListaSensor.h"
 #include "SerialPort.h"
-
-// Lista General NO Genérica que almacena punteros a SensorBase
-// Esto permite el polimorfismo
-using ListaGeneral = ListaSensor<SensorBase*>;
+#include "Metricas.h"
+#include "IngestaArduino.h"
+#include "ArnesCarga.h"
+#include "ProcesadorLotes.h"
+#include "AlmacenColumnar.h"
+#include "SalidaSilenciada.h"
+#include "TablaSimbolos.h"
+#include "MotorReglas.h"
+#include "ArnesReglas.h"
+#include "ConsultasFlota.h"
+#include "ArnesConsultas.h"
+#include "ReporteMemoria.h"
+#include "ExportadorLecturas.h"
+#include "ArnesExportacion.h"
 
 /**
  * Función para leer datos directamente desde Arduino por puerto serial
@@ -33,10 +46,17 @@ void leerDesdeArduino(ListaGeneral* listaGestion) {
     
     std::string nombrePuerto;
     std::cin >> nombrePuerto;
+    
+    int baudios;
+    int protocolo;
+    std::cout << "Velocidad (9600, 115200, 230400, 460800, 921600...): ";
+    std::cin >> baudios;
+    std::cout << "Protocolo (1 = texto, 2 = binario con CRC, 3 = automático): ";
+    std::cin >> protocolo;
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     
     // Intentar abrir el puerto
-    if (!puerto.abrir(nombrePuerto, 9600)) {
+    if (!puerto.abrir(nombrePuerto, baudios)) {
         std::cout << "\n❌ No se pudo conectar con el Arduino" << std::endl;
         std::cout << "\nSoluciones:" << std::endl;
         std::cout << "  1. Verifica que el Arduino esté conectado" << std::endl;
@@ -51,108 +71,56 @@ void leerDesdeArduino(ListaGeneral* listaGestion) {
     std::cout << "✓ Presiona Ctrl+C para detener\n" << std::endl;
     std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n" << std::endl;
     
+    ModoProtocolo solicitado = ModoProtocolo::Texto;
+    if (protocolo == 2) {
+        solicitado = ModoProtocolo::Binario;
+    } else if (protocolo == 3) {
+        solicitado = ModoProtocolo::Automatico;
+    }
+    ModoProtocolo modo = negociarProtocolo(puerto, solicitado);
+    std::cout << "✓ Protocolo: "
+              << (modo == ModoProtocolo::Binario ? "binario (tramas con CRC-16)" : "texto")
+              << "\n" << std::endl;
+    
     std::string linea;
     int lecturasRecibidas = 0;
+    ExportadorMetricas exportador;
+    auto seriesSensores = [listaGestion](std::ostream& os) {
+        escribirMetricasSensores(os, listaGestion);
+    };
+    // Corre también con el enlace en silencio: un Arduino que deja de
+    // enviar debe disparar las alertas de inactividad, y sus últimas
+    // lecturas deben llegar al archivo de exportación dentro de msEntrega
+    puerto.setTareaPeriodica(static_cast<int>(MotorReglas::PERIODO_INACTIVIDAD_NS / 1000000ULL),
+                             [&exportador, &seriesSensores]() {
+        uint64_t ahora = Metricas::ahoraNs();
+        MotorReglas::global().revisarInactividad(ahora);
+        ExportadorLecturas::global().entregarVencido(ahora, MotorReglas::PERIODO_INACTIVIDAD_NS);
+        exportador.exportarSiCorresponde(ahora, seriesSensores);
+    });
+    
+    if (modo == ModoProtocolo::Binario) {
+        DecodificadorBinario decodificador;
+        unsigned char bytes[SerialPort::TAMANIO_BUFFER];
+        size_t n;
+        
+        while ((n = puerto.leerBytes(bytes, sizeof(bytes))) > 0) {
+            uint64_t inicioNs = puerto.getMarcaLlegada();
+            decodificador.alimentar(bytes, n, [&](const TramaBinaria& trama) {
+                procesarTramaBinaria(listaGestion, trama, inicioNs);
+                lecturasRecibidas++;
+                std::cout << "📊 Total de lecturas recibidas: " << lecturasRecibidas << "\n" << std::endl;
+            });
+        }
+        return;
+    }
     
     // Leer continuamente del puerto
     while (true) {
         if (puerto.leerLinea(linea)) {
-            // Ignorar líneas de log del Arduino
-            if (linea.find("===") != std::string::npos || 
-                linea.find("Arduino") != std::string::npos ||
-                linea.find("Formato") != std::string::npos ||
-                linea.empty()) {
-                continue;
-            }
-            
-            std::cout << "📡 Recibido: " << linea << std::endl;
+            uint64_t inicioNs = puerto.getMarcaLlegada();
             
-            // Parsear la línea
-            std::istringstream iss(linea);
-            char tipo;
-            std::string id;
-            
-            if (!(iss >> tipo >> id)) {
-                // Si no tiene formato completo, intentar leer solo el número
-                std::istringstream issNumero(linea);
-                double valorPrueba;
-                if (issNumero >> valorPrueba) {
-                    // Es un número válido
-                    if (linea.find('.') != std::string::npos) {
-                        std::cout << "⚠️  Dato recibido sin formato: " << valorPrueba << std::endl;
-                        std::cout << "   📊 Tipo detectado: float (tiene punto decimal)" << std::endl;
-                    } else {
-                        std::cout << "⚠️  Dato recibido sin formato: " << (int)valorPrueba << std::endl;
-                        std::cout << "   📊 Tipo detectado: int (sin punto decimal)" << std::endl;
-                    }
-                    std::cout << "   💡 Formato esperado: T ID VALOR  o  P ID VALOR" << std::endl;
-                } else {
-                    std::cout << "⚠️  Formato inválido, ignorando..." << std::endl;
-                }
-                continue;
-            }
-            
-            // Buscar si el sensor ya existe
-            SensorBase* sensorExistente = nullptr;
-            listaGestion->iterar([&sensorExistente, &id](SensorBase* sensor) {
-                if (std::string(sensor->getNombre()) == id) {
-                    sensorExistente = sensor;
-                }
-            });
-            
-            if (tipo == 'T' || tipo == 't') {
-                float valor;
-                if (!(iss >> valor)) {
-                    std::cout << "⚠️  Valor de temperatura inválido" << std::endl;
-                    continue;
-                }
-                
-                if (sensorExistente == nullptr) {
-                    // Crear nuevo sensor de temperatura
-                    SensorTemperatura* nuevoSensor = new SensorTemperatura(id.c_str());
-                    nuevoSensor->agregarLectura(valor);
-                    listaGestion->insertarAlFinal(nuevoSensor);
-                    std::cout << "✓ Sensor de Temperatura '" << id << "' creado" << std::endl;
-                    std::cout << "  📊 Tipo de dato: float" << std::endl;
-                    std::cout << "  📈 Valor inicial: " << valor << "°C" << std::endl;
-                } else {
-                    // Agregar lectura al sensor existente
-                    SensorTemperatura* tempSensor = dynamic_cast<SensorTemperatura*>(sensorExistente);
-                    if (tempSensor) {
-                        tempSensor->agregarLectura(valor);
-                        std::cout << "✓ Lectura agregada a sensor '" << id << "'" << std::endl;
-                        std::cout << "  📊 Tipo de dato: float" << std::endl;
-                        std::cout << "  📈 Valor: " << valor << "°C" << std::endl;
-                    }
-                }
-                
-            } else if (tipo == 'P' || tipo == 'p') {
-                int valor;
-                if (!(iss >> valor)) {
-                    std::cout << "⚠️  Valor de presión inválido" << std::endl;
-                    continue;
-                }
-                
-                if (sensorExistente == nullptr) {
-                    // Crear nuevo sensor de presión
-                    SensorPresion* nuevoSensor = new SensorPresion(id.c_str());
-                    nuevoSensor->agregarLectura(valor);
-                    listaGestion->insertarAlFinal(nuevoSensor);
-                    std::cout << "✓ Sensor de Presión '" << id << "' creado" << std::endl;
-                    std::cout << "  📊 Tipo de dato: int" << std::endl;
-                    std::cout << "  📈 Valor inicial: " << valor << " Pa" << std::endl;
-                } else {
-                    // Agregar lectura al sensor existente
-                    SensorPresion* presSensor = dynamic_cast<SensorPresion*>(sensorExistente);
-                    if (presSensor) {
-                        presSensor->agregarLectura(valor);
-                        std::cout << "✓ Lectura agregada a sensor '" << id << "'" << std::endl;
-                        std::cout << "  📊 Tipo de dato: int" << std::endl;
-                        std::cout << "  📈 Valor: " << valor << " Pa" << std::endl;
-                    }
-                }
-            } else {
-                std::cout << "⚠️  Tipo de sensor desconocido: " << tipo << std::endl;
+            if (!procesarLineaArduino(listaGestion, linea, inicioNs)) {
                 continue;
             }
             
@@ -164,6 +132,236 @@ void leerDesdeArduino(ListaGeneral* listaGestion) {
 
 
 
+/**
+ * Función para ejecutar una prueba de carga con el generador sintético
+ * Simula un Arduino en un pseudo-terminal y mide la ruta de ingesta.
+ * Los sensores sintéticos van a una lista temporal que se libera al
+ * terminar; la exportación y las reglas activas se pausan para no mezclar
+ * sus lecturas ni sus alertas con las de @p listaGestion.
+ */
+void ejecutarPruebaCarga(const ListaGeneral* listaGestion) {
+    ConfigGenerador config;
+    double duracion;
+    int distribucion;
+    int protocolo;
+    
+    std::cout << "\nNúmero de sensores simulados: ";
+    std::cin >> config.numSensores;
+    std::cout << "Lecturas por segundo (0 = sin límite): ";
+    std::cin >> config.lecturasPorSegundo;
+    std::cout << "Distribución (1 = uniforme, 2 = zipf): ";
+    std::cin >> distribucion;
+    std::cout << "Proporción de líneas malformadas (0.0 - 1.0): ";
+    std::cin >> config.proporcionMalformadas;
+    std::cout << "Protocolo (1 = texto, 2 = binario con CRC): ";
+    std::cin >> protocolo;
+    std::cout << "Duración en segundos: ";
+    std::cin >> duracion;
+    
+    config.binario = (protocolo == 2);
+    
+    config.distribucion = (distribucion == 2) ? DistribucionSensores::Zipf
+                                              : DistribucionSensores::Uniforme;
+    
+    ExportadorLecturas& exportacion = ExportadorLecturas::global();
+    bool exportando = exportacion.estaActivo();
+    ConfigExportacion configExportacion = exportacion.getConfig();
+    if (exportando) {
+        exportacion.detener();
+        exportacion.imprimirResumen();
+        std::cout << "⏸  Exportación pausada durante la prueba" << std::endl;
+    }
+    MotorReglas& motor = MotorReglas::global();
+    bool conReglas = motor.estaActivo();
+    if (conReglas) {
+        motor.pausar();
+        std::cout << "⏸  Reglas de alerta pausadas durante la prueba" << std::endl;
+    }
+    
+    std::cout << "\n⏱  Ejecutando prueba de carga..." << std::endl;
+    ListaGeneral* listaPrueba;
+    {
+        SalidaSilenciada silencio;
+        listaPrueba = new ListaGeneral();
+    }
+    ResultadoCarga resultado;
+    bool ok = ArnesCarga::ejecutar(config, duracion, listaPrueba, resultado);
+    {
+        SalidaSilenciada silencio;
+        listaPrueba->iterar([&motor, listaGestion](SensorBase* sensor) {
+            // Un ID que también usa un sensor real conserva su estado
+            if (listaGestion->buscarPorId(sensor->getId()) == nullptr) {
+                motor.olvidar(sensor->getId());
+            }
+            delete sensor;
+        });
+        delete listaPrueba;
+    }
+    
+    if (conReglas) {
+        motor.reanudar();
+        std::cout << "▶  Reglas de alerta reanudadas" << std::endl;
+    }
+    if (exportando && exportacion.iniciar(configExportacion)) {
+        std::cout << "▶  Exportación reanudada en "
+                  << exportacion.nombreArchivo(exportacion.getUltimoArchivo() + 1) << std::endl;
+    }
+    if (!ok) {
+        std::cout << "❌ No se pudo iniciar el generador de carga" << std::endl;
+        return;
+    }
+    resultado.imprimir();
+}
+
+/**
+ * Consulta agregada sobre la lista de gestión (filtro por prefijo, tipo y grupos)
+ */
+void consultarFlota(ListaGeneral* listaGestion) {
+    std::string prefijo;
+    std::string tipo;
+    Consulta consulta;
+    std::cout << "\nPrefijo del ID (ej: P-1, '*' = todos): ";
+    std::cin >> prefijo;
+    std::cout << "Tipo (T, P, V, '*' = todos): ";
+    std::cin >> tipo;
+    std::cout << "Agrupar por los primeros N caracteres del ID (0 = sin grupos): ";
+    std::cin >> consulta.largoGrupo;
+    
+    if (prefijo == "*") {
+        prefijo.clear();
+    }
+    consulta.prefijo = prefijo.c_str();
+    consulta.tipo = (tipo == "T" || tipo == "P" || tipo == "V") ? tipo[0] : 0;
+    if (consulta.largoGrupo < 0) {
+        consulta.largoGrupo = 0;
+    }
+    
+    ResultadoConsulta resultado;
+    ConsultasFlota::ejecutar(listaGestion, consulta, resultado);
+    resultado.imprimir();
+}
+
+/**
+ * Carga, consulta o desactiva las reglas de alerta del motor global
+ */
+void gestionarReglas() {
+    MotorReglas& motor = MotorReglas::global();
+    std::cout << "\n--- Reglas de Alerta (" << motor.getNumReglas() << " activas) ---" << std::endl;
+    std::cout << "1 = cargar archivo, 2 = ver últimas alertas, 3 = desactivar: ";
+    int accion;
+    std::cin >> accion;
+    
+    if (accion == 1) {
+        std::string ruta;
+        std::cout << "Archivo de reglas (ej: reglas.conf): ";
+        std::cin >> ruta;
+        if (!motor.cargar(ruta.c_str())) {
+            std::cout << "❌ Se conservan las reglas anteriores" << std::endl;
+        }
+    } else if (accion == 2) {
+        motor.imprimirRecientes();
+    } else if (accion == 3) {
+        motor.desactivar();
+        std::cout << "Reglas desactivadas" << std::endl;
+    } else {
+        std::cout << "Opción inválida" << std::endl;
+    }
+}
+
+/**
+ * Reporte de memoria, compactación y presupuesto por sensor
+ */
+void gestionarMemoria(ListaGeneral* listaGestion) {
+    std::cout << "\n--- Memoria de la Flota (" << ReporteMemoria::totalFlota(listaGestion)
+              << " bytes) ---" << std::endl;
+    std::cout << "1 = ver reporte, 2 = compactar historiales, 3 = fijar presupuesto por sensor, "
+              << "4 = detalle de un sensor: ";
+    int accion;
+    std::cin >> accion;
+    
+    if (accion == 1) {
+        ReporteMemoria::imprimir(listaGestion);
+    } else if (accion == 2) {
+        size_t liberados = ReporteMemoria::compactarFlota(listaGestion);
+        std::cout << "✓ Historiales compactados: " << liberados << " bytes liberados" << std::endl;
+    } else if (accion == 3) {
+        long long bytes;
+        std::cout << "Bytes por sensor (0 = sin límite): ";
+        std::cin >> bytes;
+        if (bytes < 0) {
+            std::cout << "Presupuesto inválido" << std::endl;
+            return;
+        }
+        ReporteMemoria::fijarPresupuesto(listaGestion, static_cast<size_t>(bytes));
+        std::cout << "Presupuesto aplicado a " << listaGestion->getTamanio()
+                  << " sensores y a los nuevos" << std::endl;
+    } else if (accion == 4) {
+        std::string id;
+        std::cout << "ID del sensor: ";
+        std::cin >> id;
+        SensorBase* sensor = listaGestion->buscarPorId(TablaSimbolos::global().buscar(id.c_str()));
+        if (sensor != nullptr) {
+            sensor->imprimirInfo();
+        } else {
+            std::cout << "Sensor no encontrado" << std::endl;
+        }
+    } else {
+        std::cout << "Opción inválida" << std::endl;
+    }
+}
+
+/**
+ * Inicia, detiene o consulta la exportación de lecturas a disco
+ */
+void gestionarExportacion() {
+    ExportadorLecturas& exportador = ExportadorLecturas::global();
+    std::cout << "\n--- Exportación de Lecturas ("
+              << (exportador.estaActivo() ? "activa" : "inactiva") << ") ---" << std::endl;
+    std::cout << "1 = iniciar, 2 = detener, 3 = estado: ";
+    int accion;
+    std::cin >> accion;
+    
+    if (accion == 1) {
+        ConfigExportacion config;
+        int formato;
+        std::cout << "Prefijo de los archivos (ej: lecturas): ";
+        std::cin >> config.prefijo;
+        std::cout << "Formato (1 = CSV, 2 = binario columnar): ";
+        std::cin >> formato;
+        config.formato = (formato == 2) ? FormatoExportacion::Binario : FormatoExportacion::CSV;
+        if (exportador.iniciar(config)) {
+            std::cout << "✓ Exportando a " << exportador.nombreArchivo(exportador.getUltimoArchivo() + 1)
+                      << " (rotación cada " << config.bytesPorArchivo / (1024 * 1024) << " MiB)" << std::endl;
+        }
+    } else if (accion == 2) {
+        exportador.detener();
+        exportador.imprimirResumen();
+    } else if (accion == 3) {
+        exportador.imprimirResumen();
+    } else {
+        std::cout << "Opción inválida" << std::endl;
+    }
+}
+
+/**
+ * Lee un valor del tipo de @p Sensor y lo agrega si @p sensor es de esa clase
+ * @return false si @p sensor es de otra clase
+ */
+template <typename Sensor>
+bool leerLectura(SensorBase* sensor, const std::string& id) {
+    Sensor* tipado = comoSensor<Sensor>(sensor);
+    if (tipado == nullptr) {
+        return false;
+    }
+    typename Sensor::Valor valor;
+    std::cout << "Ingrese valor (" << Sensor::MagnitudSensor::nombreValor() << "): ";
+    std::cin >> valor;
+    tipado->agregarLectura(valor);
+    std::cout << "ID: " << id << ". Valor: " << valor << " ("
+              << Sensor::MagnitudSensor::nombreValor() << ")" << std::endl;
+    return true;
+}
+
 /**
  * Función para mostrar el menú principal
  */
@@ -177,14 +375,361 @@ void mostrarMenu() {
     std::cout << "Opción 4: Ejecutar Procesamiento" << std::endl;
     std::cout << "Opción 5: Cerrar Sistema (Liberar Memoria)" << std::endl;
     std::cout << "Opción 6: 🔌 Leer desde Arduino (Puerto Serial)" << std::endl;
+    std::cout << "Opción 7: 📊 Ver Métricas del Sistema" << std::endl;
+    std::cout << "Opción 8: ⏱  Prueba de Carga Sintética" << std::endl;
+    std::cout << "Opción 9: 🚨 Reglas de Alerta" << std::endl;
+    std::cout << "Opción 10: 📈 Consultar la Flota" << std::endl;
+    std::cout << "Opción 11: Crear Sensor (Tipo V: Vibración)" << std::endl;
+    std::cout << "Opción 12: 💾 Memoria de la Flota" << std::endl;
+    std::cout << "Opción 13: 💿 Exportar Lecturas a Disco" << std::endl;
     std::cout << "==================================" << std::endl;
     std::cout << "Seleccione una opción: ";
 }
 
+/**
+ * Muestra la ayuda de la línea de comandos
+ */
+void mostrarUso(const char* programa) {
+    std::cout << "Uso: " << programa << "                      (menú interactivo)" << std::endl;
+    std::cout << "     " << programa << " --lote ARCHIVO [--lote ARCHIVO ...] [opciones]" << std::endl;
+    std::cout << "     " << programa << " --stdin [opciones]" << std::endl;
+    std::cout << "     " << programa << " --bench-reglas [--reglas RUTA] [--sensores N] [--lecturas N] [--tasa N] [--segundos S]" << std::endl;
+    std::cout << "     " << programa << " --bench-consultas [--sensores N] [--lecturas N] [--hilos N] [--almacen TIPO]" << std::endl;
+    std::cout << "     " << programa << " --bench-exportacion [--sensores N] [--segundos S] [--exportar PREFIJO] [--conservar]" << std::endl;
+    std::cout << "\nOpciones del modo por lotes:" << std::endl;
+    std::cout << "  --lote ARCHIVO     Ingresa un registro serial capturado (repetible)" << std::endl;
+    std::cout << "  --stdin            Ingresa el registro desde la entrada estándar" << std::endl;
+    std::cout << "  --hilos N          Hilos de parseo (por defecto: núcleos disponibles)" << std::endl;
+    std::cout << "  --metricas RUTA    Escribe las métricas finales en formato Prometheus" << std::endl;
+    std::cout << "  --almacen TIPO     'lista' (por defecto) o 'columnar' para agregados de flota" << std::endl;
+    std::cout << "  --reglas RUTA      Evalúa las reglas de alerta de RUTA en cada lectura" << std::endl;
+    std::cout << "  --consulta PREFIJO Agrega las lecturas de los IDs con PREFIJO ('*' = todos)" << std::endl;
+    std::cout << "  --tipo T|P|V       Restringe la consulta a un tipo de sensor" << std::endl;
+    std::cout << "  --agrupar N        Agrupa la consulta por los primeros N caracteres del ID" << std::endl;
+    std::cout << "  --presupuesto B    Máximo de bytes de historial por sensor (descarta lo más antiguo)" << std::endl;
+    std::cout << "  --compactar        Compacta los historiales al terminar la ingesta" << std::endl;
+    std::cout << "  --memoria          Imprime el reporte de memoria de la flota" << std::endl;
+    std::cout << "  --exportar PREFIJO Escribe cada lectura en PREFIJO-NNNNNN.csv|.iotc (hilo propio)" << std::endl;
+    std::cout << "  --formato F        Formato de exportación: 'csv' (por defecto) o 'bin'" << std::endl;
+    std::cout << "  --rotar-mb N       Rota el archivo de exportación cada N MiB (0 = nunca; por defecto: 64)" << std::endl;
+    std::cout << "\nArnés del motor de reglas:" << std::endl;
+    std::cout << "  --bench-reglas     Mide agregarLectura() sin y con reglas" << std::endl;
+    std::cout << "  --sensores N       Sensores de la flota (por defecto: 1000)" << std::endl;
+    std::cout << "  --lecturas N       Lecturas por pasada (por defecto: 2000000)" << std::endl;
+    std::cout << "  --tasa N           Lecturas/s de la pasada bajo carga (0 = sin límite; por defecto: 20000)" << std::endl;
+    std::cout << "  --segundos S       Duración de la pasada bajo carga (por defecto: 5)" << std::endl;
+    std::cout << "\nArnés de consultas de flota:" << std::endl;
+    std::cout << "  --bench-consultas  Mide tres consultas con 1, 2, 4... hilos (hasta --hilos)" << std::endl;
+    std::cout << "  --sensores N       Sensores de la flota (por defecto: 10000)" << std::endl;
+    std::cout << "  --lecturas N       Lecturas por sensor (por defecto: 10000)" << std::endl;
+    std::cout << "  --almacen TIPO     'columnar' (por defecto) o 'lista' (un nodo por lectura)" << std::endl;
+    std::cout << "\nArnés de exportación:" << std::endl;
+    std::cout << "  --bench-exportacion Prueba de carga sin exportar, con CSV y con binario" << std::endl;
+    std::cout << "  --sensores N       Sensores simulados (por defecto: 1000)" << std::endl;
+    std::cout << "  --segundos S       Duración de cada corrida (por defecto: 5)" << std::endl;
+    std::cout << "  --exportar PREFIJO Prefijo de los archivos (por defecto: bench-exportacion)" << std::endl;
+    std::cout << "  --conservar        No borra los archivos generados" << std::endl;
+    std::cout << "  --ayuda            Muestra este mensaje" << std::endl;
+}
+
+/**
+ * Indica si la opción de línea de comandos consume el argumento siguiente
+ * Única lista de opciones con valor: la usan la validación y la ingesta
+ * de ejecutarModoLotes(), que deben saltar exactamente los mismos valores.
+ */
+bool flagConValor(const char* opcion) {
+    static const char* const conValor[] = {
+        "--lote", "--hilos", "--metricas", "--almacen", "--reglas", "--sensores",
+        "--lecturas", "--consulta", "--tipo", "--agrupar", "--presupuesto",
+        "--exportar", "--formato", "--rotar-mb", "--segundos", "--tasa"
+    };
+    for (size_t k = 0; k < sizeof(conValor) / sizeof(conValor[0]); k++) {
+        if (std::strcmp(opcion, conValor[k]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Modo por lotes: ingesta sin menú, procesamiento y resumen
+ * @return Código de salida del proceso
+ */
+int ejecutarModoLotes(int argc, char* argv[]) {
+    int numHilos = 0;
+    bool usarStdin = false;
+    bool columnar = false;
+    bool almacenIndicado = false;
+    bool bancoReglas = false;
+    bool bancoConsultas = false;
+    int numSensores = 0;
+    long long numLecturas = 0;
+    std::string rutaMetricas;
+    std::string rutaReglas;
+    bool hayConsulta = false;
+    bool reporteMemoria = false;
+    bool compactar = false;
+    bool bancoExportacion = false;
+    bool conservarExportacion = false;
+    double segundos = 5.0;
+    double tasa = 20000.0;
+    std::string prefijoExportacion;
+    ConfigExportacion exportacion;
+    std::string prefijoConsulta;
+    Consulta consulta;
+    
+    // Validar argumentos antes de tocar cualquier archivo
+    for (int i = 1; i < argc; i++) {
+        bool conValor = flagConValor(argv[i]);
+        if (conValor && i + 1 >= argc) {
+            std::cerr << "Error: falta el valor de " << argv[i] << std::endl;
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--hilos") == 0) {
+            numHilos = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--metricas") == 0) {
+            rutaMetricas = argv[++i];
+        } else if (std::strcmp(argv[i], "--almacen") == 0) {
+            std::string tipo = argv[++i];
+            if (tipo != "lista" && tipo != "columnar") {
+                std::cerr << "Error: almacén desconocido " << tipo << std::endl;
+                return 2;
+            }
+            columnar = (tipo == "columnar");
+            almacenIndicado = true;
+        } else if (std::strcmp(argv[i], "--reglas") == 0) {
+            rutaReglas = argv[++i];
+        } else if (std::strcmp(argv[i], "--sensores") == 0) {
+            numSensores = std::atoi(argv[++i]);
+            if (numSensores < 2) {
+                std::cerr << "Error: --sensores debe ser al menos 2" << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--lecturas") == 0) {
+            numLecturas = std::atoll(argv[++i]);
+            if (numLecturas < 1) {
+                std::cerr << "Error: --lecturas debe ser positivo" << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--bench-reglas") == 0) {
+            bancoReglas = true;
+        } else if (std::strcmp(argv[i], "--bench-consultas") == 0) {
+            bancoConsultas = true;
+        } else if (std::strcmp(argv[i], "--consulta") == 0) {
+            prefijoConsulta = argv[++i];
+            if (prefijoConsulta == "*") {
+                prefijoConsulta.clear();
+            }
+            hayConsulta = true;
+        } else if (std::strcmp(argv[i], "--tipo") == 0) {
+            std::string tipo = argv[++i];
+            if (tipo != "T" && tipo != "P" && tipo != "V") {
+                std::cerr << "Error: tipo desconocido " << tipo << std::endl;
+                return 2;
+            }
+            consulta.tipo = tipo[0];
+        } else if (std::strcmp(argv[i], "--agrupar") == 0) {
+            consulta.largoGrupo = std::atoi(argv[++i]);
+            if (consulta.largoGrupo < 0) {
+                std::cerr << "Error: --agrupar no puede ser negativo" << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--presupuesto") == 0) {
+            long long bytes = std::atoll(argv[++i]);
+            if (bytes < 0) {
+                std::cerr << "Error: --presupuesto no puede ser negativo" << std::endl;
+                return 2;
+            }
+            SensorBase::presupuestoPorDefecto() = static_cast<size_t>(bytes);
+        } else if (std::strcmp(argv[i], "--exportar") == 0) {
+            prefijoExportacion = argv[++i];
+        } else if (std::strcmp(argv[i], "--formato") == 0) {
+            std::string formato = argv[++i];
+            if (formato != "csv" && formato != "bin") {
+                std::cerr << "Error: formato de exportación desconocido " << formato << std::endl;
+                return 2;
+            }
+            exportacion.formato = (formato == "bin") ? FormatoExportacion::Binario
+                                                     : FormatoExportacion::CSV;
+        } else if (std::strcmp(argv[i], "--rotar-mb") == 0) {
+            long long mb = std::atoll(argv[++i]);
+            if (mb < 0) {
+                std::cerr << "Error: --rotar-mb no puede ser negativo" << std::endl;
+                return 2;
+            }
+            exportacion.bytesPorArchivo = static_cast<uint64_t>(mb) * 1024 * 1024;
+        } else if (std::strcmp(argv[i], "--segundos") == 0) {
+            segundos = std::atof(argv[++i]);
+            if (segundos <= 0.0) {
+                std::cerr << "Error: --segundos debe ser positivo" << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--tasa") == 0) {
+            tasa = std::atof(argv[++i]);
+            if (tasa < 0.0) {
+                std::cerr << "Error: --tasa no puede ser negativa" << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--bench-exportacion") == 0) {
+            bancoExportacion = true;
+        } else if (std::strcmp(argv[i], "--conservar") == 0) {
+            conservarExportacion = true;
+        } else if (std::strcmp(argv[i], "--memoria") == 0) {
+            reporteMemoria = true;
+        } else if (std::strcmp(argv[i], "--compactar") == 0) {
+            compactar = true;
+        } else if (std::strcmp(argv[i], "--lote") == 0) {
+            i++;
+        } else if (std::strcmp(argv[i], "--stdin") == 0) {
+            usarStdin = true;
+        } else if (std::strcmp(argv[i], "--ayuda") == 0) {
+            mostrarUso(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Error: opción desconocida " << argv[i] << std::endl;
+            mostrarUso(argv[0]);
+            return 2;
+        }
+    }
+    
+    if (bancoConsultas) {
+        ArnesConsultas::ejecutar(numSensores > 0 ? numSensores : 10000,
+                                 numLecturas > 0 ? static_cast<int>(numLecturas) : 10000,
+                                 columnar || !almacenIndicado, numHilos);
+        return 0;
+    }
+    
+    if (bancoExportacion) {
+        exportacion.prefijo = prefijoExportacion.empty() ? "bench-exportacion" : prefijoExportacion;
+        return ArnesExportacion::ejecutar(numSensores > 0 ? numSensores : 1000, segundos,
+                                          exportacion, conservarExportacion) ? 0 : 1;
+    }
+    
+    if (bancoReglas) {
+        ResultadoReglas resultado;
+        if (!ArnesReglas::ejecutar(numSensores > 0 ? numSensores : 1000,
+                                   static_cast<unsigned long long>(numLecturas > 0 ? numLecturas : 2000000),
+                                   rutaReglas.empty() ? nullptr : rutaReglas.c_str(),
+                                   tasa, segundos, resultado)) {
+            return 1;
+        }
+        resultado.imprimir();
+        return 0;
+    }
+    
+    if (!rutaReglas.empty() && !MotorReglas::global().cargar(rutaReglas.c_str())) {
+        return 1;
+    }
+    
+    // Sin ingesta en vivo, la exportación espera al escritor en lugar de descartar
+    if (!prefijoExportacion.empty()) {
+        exportacion.prefijo = prefijoExportacion;
+        exportacion.esperarEscritor = true;
+        if (!ExportadorLecturas::global().iniciar(exportacion)) {
+            return 1;
+        }
+    }
+    
+    ListaGeneral* listaGestion = new ListaGeneral();
+    AlmacenColumnar* almacen = columnar ? new AlmacenColumnar() : nullptr;
+    ProcesadorLotes lotes(numHilos);
+    bool ok = true;
+    
+    std::cout << "[Lotes] Ingesta con " << lotes.getNumHilos() << " hilos de parseo"
+              << (columnar ? " (almacén columnar)" : "") << std::endl;
+    {
+        SalidaSilenciada silencio;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--lote") == 0) {
+                const char* ruta = argv[++i];
+                ok = (columnar ? lotes.procesarArchivo(ruta, almacen)
+                               : lotes.procesarArchivo(ruta, listaGestion)) && ok;
+            } else if (flagConValor(argv[i])) {
+                i++;
+            }
+        }
+        if (usarStdin) {
+            ok = (columnar ? lotes.procesarEntradaEstandar(almacen)
+                           : lotes.procesarEntradaEstandar(listaGestion)) && ok;
+        }
+        
+        // Con el almacén columnar, la lista sólo contiene vistas SensorBase
+        if (columnar) {
+            almacen->crearVistas(listaGestion);
+        }
+    }
+    if (!ok) {
+        std::cerr << "Error: no se pudieron leer todas las fuentes" << std::endl;
+    }
+    if (ExportadorLecturas::global().estaActivo()) {
+        ExportadorLecturas::global().detener();
+        ExportadorLecturas::global().imprimirResumen();
+    }
+    
+    if (columnar) {
+        almacen->imprimirAgregadosFlota();
+    }
+    
+    // Procesamiento polimórfico
+    std::cout << "\n--- Procesando Sensores ---" << std::endl;
+    listaGestion->iterar([](SensorBase* sensor) {
+        std::cout << "-> " << sensor->getNombre() << " (" << sensor->getNumLecturas() << " lecturas) ";
+        sensor->procesarLectura();
+    });
+    
+    lotes.getResumen().imprimir(listaGestion->getTamanio());
+    
+    if (MotorReglas::global().estaActivo()) {
+        MotorReglas::global().imprimirRecientes(10);
+    }
+    
+    if (hayConsulta) {
+        consulta.prefijo = prefijoConsulta.c_str();
+        consulta.hilos = numHilos;
+        ResultadoConsulta resultado;
+        ConsultasFlota::ejecutar(listaGestion, consulta, resultado);
+        resultado.imprimir();
+    }
+    
+    if (compactar) {
+        size_t antes = ReporteMemoria::totalFlota(listaGestion);
+        size_t liberados = ReporteMemoria::compactarFlota(listaGestion);
+        std::cout << "Compactación: " << antes << " -> " << antes - liberados << " bytes ("
+                  << liberados << " liberados)" << std::endl;
+    }
+    
+    if (reporteMemoria) {
+        ReporteMemoria::imprimir(listaGestion);
+    }
+    
+    if (!rutaMetricas.empty()) {
+        std::ofstream archivo(rutaMetricas.c_str());
+        Metricas::exportarPrometheus(archivo, Metricas::instantanea());
+        escribirMetricasSensores(archivo, listaGestion);
+        std::cout << "Métricas exportadas a " << rutaMetricas << std::endl;
+    }
+    
+    // Liberar memoria sin el registro por nodo
+    {
+        SalidaSilenciada silencio;
+        listaGestion->iterar([](SensorBase* sensor) {
+            delete sensor;
+        });
+        delete listaGestion;
+        delete almacen;
+    }
+    
+    return ok ? 0 : 1;
+}
+
 /**
  * Función principal del programa
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return ejecutarModoLotes(argc, argv);
+    }
+    
     std::cout << "\n╔════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║  SISTEMA DE GESTIÓN POLIMÓRFICA DE SENSORES   ║" << std::endl;
     std::cout << "║            PARA IoT (Genérico)                 ║" << std::endl;
@@ -231,30 +776,13 @@ int main() {
                 std::cout << "\nIngrese ID del sensor: ";
                 std::cin >> id;
                 
-                SensorBase* sensorEncontrado = nullptr;
-                listaGestion->iterar([&sensorEncontrado, &id](SensorBase* sensor) {
-                    if (std::string(sensor->getNombre()) == id) {
-                        sensorEncontrado = sensor;
-                    }
-                });
+                SensorBase* sensorEncontrado =
+                    listaGestion->buscarPorId(TablaSimbolos::global().buscar(id.c_str()));
                 
                 if (sensorEncontrado != nullptr) {
-                    SensorTemperatura* tempSensor = dynamic_cast<SensorTemperatura*>(sensorEncontrado);
-                    SensorPresion* presSensor = dynamic_cast<SensorPresion*>(sensorEncontrado);
-                    
-                    if (tempSensor) {
-                        float valor;
-                        std::cout << "Ingrese valor (float): ";
-                        std::cin >> valor;
-                        tempSensor->agregarLectura(valor);
-                        std::cout << "ID: " << id << ". Valor: " << valor << " (float)" << std::endl;
-                    } else if (presSensor) {
-                        int valor;
-                        std::cout << "Ingrese valor (int): ";
-                        std::cin >> valor;
-                        presSensor->agregarLectura(valor);
-                        std::cout << "ID: " << id << ". Valor: " << valor << " (int)" << std::endl;
-                    }
+                    leerLectura<SensorTemperatura>(sensorEncontrado, id) ||
+                        leerLectura<SensorPresion>(sensorEncontrado, id) ||
+                        leerLectura<SensorVibracion>(sensorEncontrado, id);
                 } else {
                     std::cout << "Sensor no encontrado" << std::endl;
                 }
@@ -269,12 +797,9 @@ int main() {
                     std::cout << "\n-> Procesando Sensor " << sensor->getNombre() << "..." << std::endl;
                     
                     // Determinar tipo de sensor
-                    SensorTemperatura* tempSensor = dynamic_cast<SensorTemperatura*>(sensor);
-                    SensorPresion* presSensor = dynamic_cast<SensorPresion*>(sensor);
-                    
-                    if (tempSensor) {
+                    if (comoSensor<SensorTemperatura>(sensor)) {
                         std::cout << "[Sensor Temp] Promedio calculado" << std::endl;
-                    } else if (presSensor) {
+                    } else if (comoSensor<SensorPresion>(sensor)) {
                         std::cout << "[Sensor Presion] Promedio calculado" << std::endl;
                     }
                     
@@ -291,6 +816,12 @@ int main() {
                 std::cout << "\n--- Liberación de Memoria en Curso ---" << std::endl;
                 std::cout << "[Destructor General] Liberando Lista de Gestión..." << std::endl;
                 
+                // Vaciar la exportación pendiente antes de liberar los sensores
+                if (ExportadorLecturas::global().estaActivo()) {
+                    ExportadorLecturas::global().detener();
+                    ExportadorLecturas::global().imprimirResumen();
+                }
+                
                 // Liberar cada sensor de la lista
                 listaGestion->iterar([](SensorBase* sensor) {
                     delete sensor;
@@ -310,6 +841,67 @@ int main() {
                 break;
             }
             
+            case 7: {
+                // Mostrar y exportar métricas
+                std::cout << "\n--- Métricas del Sistema ---" << std::endl;
+                InstantaneaMetricas snap = Metricas::instantanea();
+                Metricas::exportarPrometheus(std::cout, snap);
+                escribirMetricasSensores(std::cout, listaGestion);
+                std::cout << "Latencia de ingesta p50/p99 (ns): "
+                          << snap.percentil(Histograma::LatenciaIngesta, 0.50) << " / "
+                          << snap.percentil(Histograma::LatenciaIngesta, 0.99) << std::endl;
+                
+                ExportadorMetricas exportador;
+                if (exportador.exportar([listaGestion](std::ostream& os) {
+                        escribirMetricasSensores(os, listaGestion);
+                    })) {
+                    std::cout << "Métricas exportadas a " << exportador.getRuta() << std::endl;
+                }
+                break;
+            }
+            
+            case 8: {
+                // Generador sintético + arnés de rendimiento
+                ejecutarPruebaCarga(listaGestion);
+                break;
+            }
+            
+            case 9: {
+                // Reglas de alerta evaluadas en cada lectura
+                gestionarReglas();
+                break;
+            }
+            
+            case 10: {
+                // Agregados de flota con reducción en paralelo
+                consultarFlota(listaGestion);
+                break;
+            }
+            
+            case 11: {
+                // Crear Sensor de Vibración
+                std::string id;
+                std::cout << "\nIngrese ID del sensor (ej: V-001): ";
+                std::cin >> id;
+                
+                SensorVibracion* nuevoSensor = new SensorVibracion(id.c_str());
+                listaGestion->insertarAlFinal(nuevoSensor);
+                std::cout << "Sensor 'V-" << id << "' creado e insertado" << std::endl;
+                break;
+            }
+            
+            case 12: {
+                // Contabilidad de memoria, compactación y presupuestos
+                gestionarMemoria(listaGestion);
+                break;
+            }
+            
+            case 13: {
+                // Exportación asíncrona de lecturas (CSV o binario)
+                gestionarExportacion();
+                break;
+            }
+            
             default:
                 std::cout << "Opción inválida. Intente nuevamente." << std::endl;
                 break;